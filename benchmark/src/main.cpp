@@ -0,0 +1,202 @@
+#include "ofMain.h"
+#include "ofxBlender.h"
+#include "BlendWriter.h"
+#include <chrono>
+
+//loads blend files a number of times without a window or GL context and reports the median and 95th percentile of
+//File::load, getScene, meshes and keyframes per second and (with -profile) of the load phases
+//
+//usage: benchmark [-n runs] [-threads n] [-profile] [-json path] [-generate objectsxvertices ...] [file.blend ...]
+//without files example/bin/data/test.blend is loaded. -generate 10000x500 writes a file with 10000 objects of 500
+//vertices each (with materials, uvs and animations) through BlendWriter and adds it to the files
+
+using namespace ofx::blender;
+
+struct Samples {
+	string name;
+	string unit;
+	std::vector<double> values;
+
+	double getPercentile(double percentile) const {
+		if(values.empty())
+			return 0;
+		std::vector<double> sorted = values;
+		std::sort(sorted.begin(), sorted.end());
+		//nearest rank
+		unsigned int rank = std::ceil(percentile * sorted.size());
+		return sorted[std::max(rank, 1u) - 1];
+	}
+};
+
+struct FileResult {
+	string path;
+	unsigned int numMeshes;
+	unsigned int numKeyframes;
+	std::vector<Samples> samples;
+
+	Samples& get(const string& name, const string& unit) {
+		for(Samples& s: samples) {
+			if(s.name == name)
+				return s;
+		}
+		Samples s;
+		s.name = name;
+		s.unit = unit;
+		samples.push_back(s);
+		return samples.back();
+	}
+};
+
+static double getMillisSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static unsigned int countKeyframes(Scene* scene) {
+	unsigned int numKeyframes = scene->timeline.getNumKeyframes();
+	for(unsigned int i=0; scene->getObject(i); i++)
+		numKeyframes += scene->getObject(i)->timeline.getNumKeyframes();
+	return numKeyframes;
+}
+
+static bool runFile(const string& path, unsigned int runs, unsigned int threads, bool profile, FileResult& result) {
+	result.path = path;
+	result.numMeshes = 0;
+	result.numKeyframes = 0;
+	for(unsigned int run=0; run<runs; run++) {
+		//a fresh file every run, nothing is reused from the previous one
+		File file;
+		file.uploadToGpu = false;
+		file.profiling = profile;
+		file.parallelParsing = threads != 1;
+		file.numThreads = threads;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		if(!file.load(path)) {
+			ofLogError("benchmark") << "could not load " << path;
+			return false;
+		}
+		double loadTime = getMillisSince(start);
+
+		start = std::chrono::steady_clock::now();
+		Scene* scene = file.getScene();
+		double sceneTime = getMillisSince(start);
+		if(!scene) {
+			ofLogError("benchmark") << path << " has no scene";
+			return false;
+		}
+
+		result.numMeshes = scene->getMeshes().size();
+		result.numKeyframes = countKeyframes(scene);
+		double seconds = std::max(sceneTime, 0.001) / 1000.0;
+		result.get("load", "ms").values.push_back(loadTime);
+		result.get("getScene", "ms").values.push_back(sceneTime);
+		result.get("meshesPerSecond", "1/s").values.push_back(result.numMeshes / seconds);
+		result.get("keyframesPerSecond", "1/s").values.push_back(result.numKeyframes / seconds);
+
+		if(profile) {
+			LoadProfile loadProfile = file.getProfile();
+			for(unsigned int i=0; i<LoadProfile::NUM_PHASES; i++) {
+				LoadProfile::Phase phase = LoadProfile::Phase(i);
+				result.get(LoadProfile::getPhaseName(phase), "ms").values.push_back(loadProfile.phases[i].millis);
+				if(phase == LoadProfile::MESH_BUILD || phase == LoadProfile::TEXTURE_DECODE)
+					result.get(LoadProfile::getPhaseName(phase) + "Threads", "ms").values.push_back(loadProfile.phases[i].threadMillis);
+			}
+		}
+	}
+	return true;
+}
+
+static string toJson(const std::vector<FileResult>& results, unsigned int runs, unsigned int threads) {
+	std::ostringstream out;
+	out << "{\n\t\"runs\": " << runs << ",\n\t\"threads\": " << threads << ",\n\t\"files\": [";
+	for(unsigned int i=0; i<results.size(); i++) {
+		const FileResult& result = results[i];
+		out << (i == 0 ? "\n" : ",\n") << "\t\t{\n";
+		out << "\t\t\t\"path\": \"" << result.path << "\",\n";
+		out << "\t\t\t\"meshes\": " << result.numMeshes << ",\n";
+		out << "\t\t\t\"keyframes\": " << result.numKeyframes << ",\n";
+		out << "\t\t\t\"metrics\": {";
+		for(unsigned int j=0; j<result.samples.size(); j++) {
+			const Samples& s = result.samples[j];
+			out << (j == 0 ? "\n" : ",\n") << "\t\t\t\t\"" << s.name << "\": {\"unit\": \"" << s.unit << "\", \"median\": " << s.getPercentile(.5) << ", \"p95\": " << s.getPercentile(.95) << "}";
+		}
+		out << "\n\t\t\t}\n\t\t}";
+	}
+	out << "\n\t]\n}\n";
+	return out.str();
+}
+
+int main(int argc, char** argv) {
+	unsigned int runs = 10;
+	unsigned int threads = 1;
+	bool profile = false;
+	string jsonPath;
+	std::vector<string> paths;
+	std::vector<string> generate;
+	for(int i=1; i<argc; i++) {
+		string arg = argv[i];
+		if(arg == "-n" && i + 1 < argc)
+			runs = std::max(ofToInt(argv[++i]), 1);
+		else if(arg == "-threads" && i + 1 < argc)
+			threads = std::max(ofToInt(argv[++i]), 0);
+		else if(arg == "-profile")
+			profile = true;
+		else if(arg == "-json" && i + 1 < argc)
+			jsonPath = argv[++i];
+		else if(arg == "-generate" && i + 1 < argc)
+			generate.push_back(argv[++i]);
+		else
+			paths.push_back(arg);
+	}
+	string templatePath = ofFilePath::join(ofFilePath::getCurrentExeDir(), "../../example/bin/data/test.blend");
+	if(paths.empty() && generate.empty())
+		paths.push_back(templatePath);
+
+	if(!generate.empty()) {
+		BlendWriter writer;
+		if(!writer.setTemplate(templatePath))
+			return 1;
+		for(string& size: generate) {
+			std::vector<string> counts = ofSplitString(size, "x");
+			BlendWriter::Settings settings;
+			settings.numObjects = ofToInt(counts[0]);
+			settings.verticesPerMesh = counts.size() > 1 ? ofToInt(counts[1]) : 100;
+			settings.hierarchyDepth = 4;
+			settings.numMaterials = 4;
+			settings.curvesPerObject = 3;
+			settings.keyframesPerCurve = 10;
+			settings.numMarkers = 10;
+			string path = ofToDataPath("generated_" + size + ".blend", true);
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			if(!writer.write(path, settings))
+				return 1;
+			cout << "generated " << path << " (" << writer.getNumBytesWritten() << " bytes) in " << getMillisSince(start) << " ms" << endl;
+			paths.push_back(path);
+		}
+	}
+
+	//parser warnings would be repeated every run
+	ofSetLogLevel(OFX_BLENDER, OF_LOG_ERROR);
+
+	std::vector<FileResult> results;
+	for(string& path: paths) {
+		FileResult result;
+		if(!runFile(path, runs, threads, profile, result))
+			return 1;
+		results.push_back(result);
+
+		cout << path << " (" << result.numMeshes << " meshes, " << result.numKeyframes << " keyframes, " << runs << " runs)" << endl;
+		for(Samples& s: result.samples)
+			cout << "  " << s.name << ": median " << s.getPercentile(.5) << " " << s.unit << ", p95 " << s.getPercentile(.95) << " " << s.unit << endl;
+	}
+
+	if(!jsonPath.empty()) {
+		ofstream out(jsonPath.c_str());
+		out << toJson(results, runs, threads);
+		if(!out) {
+			ofLogError("benchmark") << "could not write " << jsonPath;
+			return 1;
+		}
+	}
+	return 0;
+}
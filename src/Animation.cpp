@@ -232,7 +232,8 @@ struct markerSort {
 };
 
 void Timeline::addMarker(float time, string name) {
-	markers.push_back(new Marker(time * 1000, name));
+	ownedMarkers.push_back(std::shared_ptr<Marker>(new Marker(time * 1000, name)));
+	markers.push_back(ownedMarkers.back().get());
 	std::sort(markers.begin(), markers.end(), markerSort());
 }
 
@@ -332,6 +333,27 @@ bool Timeline::hasAnimations() {
 	return animations.size() > 0;
 }
 
+unsigned int Timeline::getNumKeyframes() {
+	unsigned int numKeyframes = 0;
+	for(Animation_* anim: animations)
+		numKeyframes += anim->getNumKeyframes();
+	return numKeyframes;
+}
+
+void Timeline::addMemoryUsage(MemoryReport& report, const string& owner) {
+	for(Animation_* anim: animations) {
+		report.add(MemoryReport::KEYFRAMES, owner + " " + anim->address + "[" + ofToString(anim->channel) + "]", anim->getMemoryUsage());
+		report.add(MemoryReport::NAMES, owner + " " + anim->address, MemoryReport::getBytes(anim->address));
+	}
+	if(!markers.empty()) {
+		size_t markerNames = 0;
+		for(Marker* marker: markers)
+			markerNames += MemoryReport::getBytes(marker->name);
+		report.add(MemoryReport::KEYFRAMES, owner + " markers", MemoryReport::getBytes(markers) + markers.size() * sizeof(Marker));
+		report.add(MemoryReport::NAMES, owner + " markers", markerNames);
+	}
+}
+
 
 }
 }
@@ -3,7 +3,10 @@
 
 #include "Utils.h"
 #include <typeindex>
+#include <deque>
+#include <memory>
 #include "Interpolation.h"
+#include "MemoryReport.h"
 
 namespace ofx {
 
@@ -17,6 +20,7 @@ public:
 	// little helper class to have templated default handlers for timeline events
 	class DefaultHandler_ {
 	public:
+		virtual ~DefaultHandler_() {}
 		virtual std::type_index getType()=0;
 	};
 
@@ -45,18 +49,18 @@ public:
 		void call(Type value, string address, int channel) {
 			std::type_index type(typeid(Type));
 			if(handlers.find(type) != handlers.end()) {
-				DefaultHandler<Type>* handler = static_cast<DefaultHandler<Type>*>(handlers[type]);
+				DefaultHandler<Type>* handler = static_cast<DefaultHandler<Type>*>(handlers[type].get());
 				handler->call(value, address, channel);
 			}
 		}
 
 		template<typename Type>
 		void add(std::function<void(Type&, string, int)> listener) {
-			DefaultHandler<Type>* handler = new DefaultHandler<Type>(listener);
+			std::shared_ptr<DefaultHandler_> handler(new DefaultHandler<Type>(listener));
 			handlers[handler->getType()] = handler;
 		}
 
-		std::map<std::type_index, DefaultHandler_*> handlers;
+		std::map<std::type_index, std::shared_ptr<DefaultHandler_> > handlers;
 	};
 	/////////////////////////////////////////////////////////////////////
 
@@ -70,6 +74,8 @@ public:
 		defaultHandler = NULL;
 	}
 
+	virtual ~Animation_() {}
+
 	void step(unsigned long long timeNow) {
 		timeNow -= timeOffset;
 		onStep(timeNow, timeLast);
@@ -81,7 +87,7 @@ public:
 		return std::type_index(typeid(Type)) == type;
 	}
 
-	void clear() {
+	virtual void clear() {
 		keyframes.clear();
 	}
 
@@ -91,6 +97,15 @@ public:
 		return getKeyframeAfter(timeLast) != NULL;
 	}
 
+	size_t getNumKeyframes() {
+		return keyframes.size();
+	}
+
+	//bytes of the keyframes
+	virtual size_t getMemoryUsage() {
+		return MemoryReport::getBytes(keyframes);
+	}
+
 	int channel;
 	string address;
 	bool isLoop;
@@ -113,9 +128,9 @@ protected:
 		}
 	};
 
+	//keyframes are owned by the animation, see Animation::addKeyframe
 	void addKeyframe(Keyframe* keyframe) {
-		keyframes.push_back(keyframe);
-		std::sort(keyframes.begin(), keyframes.end(), keyFrameSort());
+		keyframes.insert(std::upper_bound(keyframes.begin(), keyframes.end(), keyframe, keyFrameSort()), keyframe);
 	}
 
 	Keyframe* getKeyframeBefore(unsigned long long time) {
@@ -234,13 +249,22 @@ public:
 	}
 
 	void addKeyframe(double time, Type value, ofVec2f p, ofVec2f h1, ofVec2f h2) {
-		Keyframe* key = new Keyframe(time, value, p, h1, h2);
-		Animation_::addKeyframe(key);
+		keyframeStorage.push_back(Keyframe(time, value, p, h1, h2));
+		Animation_::addKeyframe(&keyframeStorage.back());
 	}
 
 	void addKeyframe(double time, Type value, InterpolationType type = LINEAR) {
-		Keyframe* key = new Keyframe(time, value, type);
-		Animation_::addKeyframe(key);
+		keyframeStorage.push_back(Keyframe(time, value, type));
+		Animation_::addKeyframe(&keyframeStorage.back());
+	}
+
+	void clear() {
+		Animation_::clear();
+		keyframeStorage.clear();
+	}
+
+	size_t getMemoryUsage() {
+		return Animation_::getMemoryUsage() + keyframeStorage.size() * sizeof(Keyframe);
 	}
 
 	typedef std::function<void(Type&, string, int)> Listener;
@@ -271,6 +295,8 @@ public:
 	}
 
 private:
+	//a deque keeps the keyframes in place when it grows
+	std::deque<Keyframe> keyframeStorage;
 	std::vector<Listener> listeners;
 	Type oldValue;
 	bool oldValueSet;
@@ -315,9 +341,10 @@ public:
 				}
 			}
 		}
-		Animation<Type>* newAnim = new Animation<Type>(address, channel);
-		add(newAnim);
-		return newAnim;
+		std::shared_ptr<Animation<Type> > newAnim(new Animation<Type>(address, channel));
+		ownedAnimations.push_back(newAnim);
+		add(newAnim.get());
+		return newAnim.get();
 	}
 
 	void play();
@@ -340,6 +367,11 @@ public:
 	bool hasAnimation(string key);
 	bool hasAnimation(string key, int channel);
 	bool hasAnimations();
+	//keyframes of all animations, child timelines are not included
+	unsigned int getNumKeyframes();
+
+	//keyframes, markers and their names, child timelines are not included
+	void addMemoryUsage(MemoryReport& report, const string& owner);
 
 	template<typename Type>
 	void animateTo(Type from, Type to, float duration, string address, int channel=0, InterpolationType interpolation=LINEAR) {
@@ -382,6 +414,9 @@ private:
 	std::vector<Animation_*> animations;
 	std::vector<Timeline*> children;
 	std::vector<Marker*> markers;
+	//markers and animations created by the timeline itself, parsed animations are owned by the file
+	std::vector<std::shared_ptr<Marker> > ownedMarkers;
+	std::vector<std::shared_ptr<Animation_> > ownedAnimations;
 	void triggerMarker(Marker* marker);
 	Marker* lastMarker;
 	//TODO: fix marker queue
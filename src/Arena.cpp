@@ -0,0 +1,85 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace ofx {
+namespace blender {
+
+Arena::Arena(size_t chunkSize) {
+	this->chunkSize = chunkSize;
+	current = NULL;
+	available = 0;
+	numBytes = 0;
+	numBytesUsed = 0;
+	numObjects = 0;
+}
+
+Arena::~Arena() {
+	clear();
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t padding = current ? (alignment - reinterpret_cast<uintptr_t>(current) % alignment) % alignment : 0;
+	if(current == NULL || padding + size > available) {
+		//objects bigger than a chunk get their own
+		size_t newSize = std::max(chunkSize, size + alignment);
+		char* chunk = static_cast<char*>(::operator new(newSize));
+		chunks.push_back(chunk);
+		numBytes += newSize;
+		current = chunk;
+		available = newSize;
+		padding = (alignment - reinterpret_cast<uintptr_t>(current) % alignment) % alignment;
+	}
+	char* memory = current + padding;
+	current = memory + size;
+	available -= padding + size;
+	numBytesUsed += size;
+	numObjects++;
+	return memory;
+}
+
+void Arena::addDestructor(void* object, void (*destroy)(void*)) {
+	std::lock_guard<std::mutex> lock(mutex);
+	Destructor destructor = {object, destroy};
+	destructors.push_back(destructor);
+}
+
+void Arena::clear() {
+	std::vector<Destructor> toDestroy;
+	std::vector<char*> toRelease;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		toDestroy.swap(destructors);
+		toRelease.swap(chunks);
+		current = NULL;
+		available = 0;
+		numBytes = 0;
+		numBytesUsed = 0;
+		numObjects = 0;
+	}
+
+	//destructors might create or look up other objects, so they run without the lock
+	for(std::vector<Destructor>::reverse_iterator it = toDestroy.rbegin(); it != toDestroy.rend(); it++)
+		it->destroy(it->object);
+	for(char* chunk: toRelease)
+		::operator delete(chunk);
+}
+
+size_t Arena::getNumObjects() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return numObjects;
+}
+
+size_t Arena::getNumBytes() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return numBytes;
+}
+
+size_t Arena::getNumBytesUsed() {
+	std::lock_guard<std::mutex> lock(mutex);
+	return numBytesUsed;
+}
+
+}
+}
@@ -0,0 +1,71 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ofx {
+namespace blender {
+
+//owns everything parsed from a file. objects are placed one after another in large chunks and destroyed
+//together, in reverse order of creation, when the arena is cleared or destroyed. files hand out the arena
+//as a shared_ptr so parsed scenes can outlive a reload of the file
+class Arena {
+public:
+	Arena(size_t chunkSize=64*1024);
+	~Arena();
+
+	template<typename Type, typename... Args>
+	Type* create(Args&&... args) {
+		void* memory = allocate(sizeof(Type), alignof(Type));
+		Type* object = new(memory) Type(std::forward<Args>(args)...);
+		if(!std::is_trivially_destructible<Type>::value)
+			addDestructor(object, &destroy<Type>);
+		return object;
+	}
+
+	void* allocate(size_t size, size_t alignment);
+	//destroys all objects and releases the memory
+	void clear();
+
+	size_t getNumObjects();
+	//bytes reserved for chunks
+	size_t getNumBytes();
+	//bytes handed out
+	size_t getNumBytesUsed();
+
+private:
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+	template<typename Type>
+	static void destroy(void* object) {
+		static_cast<Type*>(object)->~Type();
+	}
+
+	void addDestructor(void* object, void (*destructor)(void*));
+
+	struct Destructor {
+		void* object;
+		void (*destroy)(void*);
+	};
+
+	size_t chunkSize;
+	std::vector<char*> chunks;
+	char* current;
+	size_t available;
+	size_t numBytes;
+	size_t numBytesUsed;
+	size_t numObjects;
+	std::vector<Destructor> destructors;
+	std::mutex mutex;
+};
+
+}
+}
+
+#endif // ARENA_H
@@ -0,0 +1,85 @@
+#ifndef BLENDER_ARRAYVIEW_H
+#define BLENDER_ARRAYVIEW_H
+
+#include "ByteOrder.h"
+#include <memory>
+#include <vector>
+
+namespace ofx {
+namespace blender {
+
+//typed, strided view on values inside the file bytes, e.g. the co field of every MVert in a block
+//every element has a fixed number of components (3 for co[3]), values are byte swapped on access if needed
+//views on mapped files point straight into the file and are valid until the file is loaded again, views
+//on streamed files own a copy of the bytes
+template<typename Type>
+class ArrayView {
+public:
+	ArrayView() {
+		data = NULL;
+		numElements = 0;
+		stride = 0;
+		components = 1;
+		swap = false;
+	}
+
+	ArrayView(const char* data, size_t numElements, size_t stride, unsigned int components, bool swap, std::shared_ptr<std::vector<char> > owned=std::shared_ptr<std::vector<char> >()) {
+		this->data = data;
+		this->numElements = numElements;
+		this->stride = stride;
+		this->components = components;
+		this->swap = swap;
+		this->owned = owned;
+	}
+
+	size_t size() const {
+		return numElements;
+	}
+
+	bool empty() const {
+		return numElements == 0;
+	}
+
+	unsigned int getComponents() const {
+		return components;
+	}
+
+	Type get(size_t index, unsigned int component=0) const {
+		Type ret;
+		memcpy(&ret, data + index * stride + component * sizeof(Type), sizeof(Type));
+		if(swap)
+			ByteSwap<sizeof(Type)>::apply(reinterpret_cast<char*>(&ret), 1);
+		return ret;
+	}
+
+	Type operator[](size_t index) const {
+		return get(index);
+	}
+
+	//copies all values to out, size() * getComponents() values with the components of an element next to each other
+	void copyTo(Type* out) const {
+		size_t elementSize = components * sizeof(Type);
+		if(stride == elementSize) {
+			memcpy(out, data, numElements * elementSize);
+		} else {
+			for(size_t i=0; i<numElements; i++) {
+				memcpy(out + i * components, data + i * stride, elementSize);
+			}
+		}
+		if(swap)
+			ByteSwap<sizeof(Type)>::apply(reinterpret_cast<char*>(out), numElements * components);
+	}
+
+private:
+	const char* data;
+	size_t numElements;
+	size_t stride;
+	unsigned int components;
+	bool swap;
+	std::shared_ptr<std::vector<char> > owned;
+};
+
+}
+}
+
+#endif // BLENDER_ARRAYVIEW_H
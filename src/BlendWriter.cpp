@@ -0,0 +1,640 @@
+#include "BlendWriter.h"
+#include <cstring>
+
+namespace ofx {
+namespace blender {
+
+//CustomData layer type of MLoopUV and the smooth flag of MPoly
+#define CD_MLOOPUV 16
+#define ME_SMOOTH 1
+#define OB_MESH 1
+#define BEZT_IPO_BEZ 2
+
+//frames between two keyframes and markers
+#define FRAME_STEP 10
+
+BlendWriter::Settings::Settings() {
+	numObjects = 100;
+	hierarchyDepth = 1;
+	verticesPerMesh = 100;
+	triangles = 1;
+	quads = 1;
+	ngons = 0;
+	numUVLayers = 1;
+	numMaterials = 1;
+	curvesPerObject = 0;
+	keyframesPerCurve = 0;
+	numMarkers = 0;
+	seed = 0;
+}
+
+BlendWriter::BlendWriter() {
+	hasTemplate = false;
+	numBytesWritten = 0;
+}
+
+bool BlendWriter::setTemplate(string path) {
+	hasTemplate = false;
+	fields.clear();
+	dna.clear();
+	if(!templateFile.load(path))
+		return false;
+	if(templateFile.layout != LAYOUT_32_NATIVE && templateFile.layout != LAYOUT_64_NATIVE) {
+		ofLogWarning(OFX_BLENDER) << "BlendWriter: template \"" << path << "\" is not in the byte order of this machine";
+		return false;
+	}
+	for(File::Block& block: templateFile.blocks) {
+		if(block.code == "DNA1")
+			dna = templateFile.readCharAt(block.offset, block.size);
+	}
+	if(dna.empty()) {
+		ofLogWarning(OFX_BLENDER) << "BlendWriter: template \"" << path << "\" has no DNA catalog";
+		return false;
+	}
+
+	const char* required[] = {"Scene", "Base", "World", "TimeMarker", "Object", "Mesh", "MVert", "MPoly", "MLoop",
+	                          "MLoopUV", "CustomDataLayer", "Material", "AnimData", "bAction", "FCurve", "BezTriple"};
+	for(const char* structName: required) {
+		if(!templateFile.catalog.hasStructure(structName)) {
+			ofLogWarning(OFX_BLENDER) << "BlendWriter: template \"" << path << "\" has no " << structName << " structure";
+			return false;
+		}
+	}
+	hasTemplate = true;
+	return true;
+}
+
+unsigned long long BlendWriter::getNumBytesWritten() {
+	return numBytesWritten;
+}
+
+const BlendWriter::FieldRef& BlendWriter::getField(const string& structName, const string& path) {
+	string key = structName + "." + path;
+	std::unordered_map<std::string, FieldRef>::iterator it = fields.find(key);
+	if(it != fields.end())
+		return it->second;
+
+	//walk down the nested structures, fields missing in this version stay unsupported and are not written
+	FieldRef ref;
+	DNACatalog& catalog = templateFile.catalog;
+	int structureIndex = catalog.getStructureIndex(structName);
+	std::vector<string> names = ofSplitString(path, ".");
+	unsigned int offset = 0;
+	for(unsigned int i=0; i<names.size() && structureIndex != -1; i++) {
+		DNAStructure& structure = catalog.structures[structureIndex];
+		int fieldIndex = structure.getFieldIndex(names[i]);
+		if(fieldIndex == -1)
+			break;
+		DNAField& field = structure.fields[fieldIndex];
+		offset += field.offset;
+		if(i + 1 < names.size()) {
+			structureIndex = field.structureIndex;
+			continue;
+		}
+
+		ref.offset = offset;
+		ref.size = field.isPointer ? templateFile.pointerSize : field.type->size;
+		const string& type = field.type->name;
+		if(field.isPointer)
+			ref.type = POINTER;
+		else if(type == "char")
+			ref.type = CHAR;
+		else if(type == "uchar")
+			ref.type = UCHAR;
+		else if(type == "short")
+			ref.type = SHORT;
+		else if(type == "ushort")
+			ref.type = USHORT;
+		else if(type == "int")
+			ref.type = INT;
+		else if(type == "float")
+			ref.type = FLOAT;
+		else if(type == "double")
+			ref.type = DOUBLE;
+		else if(type == "int64_t" || type == "uint64_t")
+			ref.type = INT64;
+	}
+	return fields.insert(std::make_pair(key, ref)).first->second;
+}
+
+BlendWriter::StructRef BlendWriter::getStruct(const string& structName) {
+	StructRef ref;
+	ref.sdnaIndex = templateFile.catalog.getStructureIndex(structName);
+	ref.size = ref.sdnaIndex != -1 ? templateFile.catalog.structures[ref.sdnaIndex].type->size : 0;
+	return ref;
+}
+
+template<typename Type>
+static void writeRaw(char* data, Type value) {
+	memcpy(data, &value, sizeof(Type));
+}
+
+void BlendWriter::setValue(char* data, const FieldRef& field, double value, unsigned int index) {
+	char* at = data + field.offset + index * field.size;
+	switch(field.type) {
+	case CHAR: writeRaw<char>(at, value); break;
+	case UCHAR: writeRaw<unsigned char>(at, value); break;
+	case SHORT: writeRaw<short>(at, value); break;
+	case USHORT: writeRaw<unsigned short>(at, value); break;
+	case INT: writeRaw<int>(at, value); break;
+	case FLOAT: writeRaw<float>(at, value); break;
+	case DOUBLE: writeRaw<double>(at, value); break;
+	case INT64: writeRaw<long long>(at, value); break;
+	case POINTER: setPointerValue(data, field, value, index); break;
+	case UNSUPPORTED: break;
+	}
+}
+
+void BlendWriter::setPointerValue(char* data, const FieldRef& field, unsigned long long address, unsigned int index) {
+	if(field.type != POINTER)
+		return;
+	char* at = data + field.offset + index * field.size;
+	if(field.size == 4)
+		writeRaw<unsigned int>(at, address);
+	else
+		writeRaw<unsigned long long>(at, address);
+}
+
+void BlendWriter::set(std::vector<char>& data, const string& structName, const string& path, double value, unsigned int index, size_t base) {
+	setValue(&data[base], getField(structName, path), value, index);
+}
+
+void BlendWriter::setPointer(std::vector<char>& data, const string& structName, const string& path, unsigned long long address, unsigned int index, size_t base) {
+	setPointerValue(&data[base], getField(structName, path), address, index);
+}
+
+void BlendWriter::setName(std::vector<char>& data, const string& structName, const string& path, const string& name, size_t base) {
+	const FieldRef& field = getField(structName, path);
+	if(field.type != CHAR)
+		return;
+	//the field's array size isn't kept in the ref, names are cut at 63 characters which fits all name fields
+	size_t length = std::min<size_t>(name.size(), 63);
+	if(base + field.offset + length < data.size())
+		memcpy(&data[base + field.offset], name.data(), length);
+}
+
+void BlendWriter::writeHeader(std::ostream& out, const string& code, size_t size, unsigned long long address, int sdnaIndex, unsigned int count) {
+	char header[24] = {0};
+	memcpy(header, code.data(), std::min<size_t>(code.size(), 4));
+	writeRaw<unsigned int>(header + 4, size);
+	unsigned int pointerSize = templateFile.pointerSize;
+	if(pointerSize == 4)
+		writeRaw<unsigned int>(header + 8, address);
+	else
+		writeRaw<unsigned long long>(header + 8, address);
+	writeRaw<unsigned int>(header + 8 + pointerSize, sdnaIndex);
+	writeRaw<unsigned int>(header + 12 + pointerSize, count);
+	out.write(header, 16 + pointerSize);
+}
+
+void BlendWriter::writeBlock(std::ostream& out, const string& code, const std::vector<char>& data, unsigned long long address, int sdnaIndex, unsigned int count) {
+	writeHeader(out, code, data.size(), address, sdnaIndex, count);
+	if(!data.empty())
+		out.write(&data[0], data.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//same value for the same seed and index on every platform
+static float hashToUnit(unsigned int seed, unsigned int index) {
+	unsigned int h = index * 0x9e3779b9u ^ (seed + 0x7f4a7c15u);
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35u;
+	h ^= h >> 16;
+	return (h >> 8) / 16777216.f;
+}
+
+static unsigned long long alignAddress(unsigned long long size) {
+	return (size + 15) & ~15ULL;
+}
+
+//the grid cells are visited in pairs, a pair is either one ngon or two cells that are each a quad or two triangles
+static void forEachPolygon(unsigned int width, unsigned int height, const BlendWriter::Settings& settings, std::function<void(const unsigned int*, unsigned int)> func) {
+	float total = std::max(settings.triangles, 0.f) + std::max(settings.quads, 0.f) + std::max(settings.ngons, 0.f);
+	if(total <= 0)
+		total = 1;
+	float ngonChance = std::max(settings.ngons, 0.f) / total;
+	float cellTotal = std::max(settings.triangles, 0.f) + std::max(settings.quads, 0.f);
+	float triangleChance = cellTotal > 0 ? std::max(settings.triangles, 0.f) / cellTotal : 0;
+
+	unsigned int verts[6];
+	unsigned int cellsPerRow = width - 1;
+	for(unsigned int y=0; y+1<height; y++) {
+		for(unsigned int x=0; x<cellsPerRow; x+=2) {
+			unsigned int a = y * width + x;
+			if(x + 1 < cellsPerRow && hashToUnit(settings.seed, a) < ngonChance) {
+				unsigned int ngon[6] = {a, a + 1, a + 2, a + width + 2, a + width + 1, a + width};
+				func(ngon, 6);
+				continue;
+			}
+			for(unsigned int cell=x; cell<x+2 && cell<cellsPerRow; cell++) {
+				unsigned int c = y * width + cell;
+				if(hashToUnit(settings.seed + 1, c) < triangleChance) {
+					verts[0] = c; verts[1] = c + 1; verts[2] = c + width + 1;
+					func(verts, 3);
+					verts[0] = c; verts[1] = c + width + 1; verts[2] = c + width;
+					func(verts, 3);
+				} else {
+					verts[0] = c; verts[1] = c + 1; verts[2] = c + width + 1; verts[3] = c + width;
+					func(verts, 4);
+				}
+			}
+		}
+	}
+}
+
+//collects elements of an array block and writes them in chunks, large meshes are never held in memory as a whole
+class ArrayBlockWriter {
+public:
+	ArrayBlockWriter(std::ostream& o, unsigned int size):out(o), elementSize(size) {
+		chunk.reserve(elementSize * 4096);
+	}
+
+	~ArrayBlockWriter() {
+		flush();
+	}
+
+	//a zeroed element to fill in
+	char* add() {
+		if(chunk.size() + elementSize > chunk.capacity())
+			flush();
+		chunk.resize(chunk.size() + elementSize, 0);
+		return &chunk[chunk.size() - elementSize];
+	}
+
+	void flush() {
+		if(!chunk.empty())
+			out.write(&chunk[0], chunk.size());
+		chunk.clear();
+	}
+
+private:
+	std::ostream& out;
+	unsigned int elementSize;
+	std::vector<char> chunk;
+};
+
+bool BlendWriter::write(string path, const Settings& settings) {
+	numBytesWritten = 0;
+	if(!hasTemplate) {
+		ofLogWarning(OFX_BLENDER) << "BlendWriter: set a template before writing";
+		return false;
+	}
+
+	std::ofstream out(ofToDataPath(path, true).c_str(), ios::binary);
+	if(!out) {
+		ofLogWarning(OFX_BLENDER) << "BlendWriter: could not open \"" << path << "\" for writing";
+		return false;
+	}
+
+	StructRef sceneStruct = getStruct("Scene");
+	StructRef baseStruct = getStruct("Base");
+	StructRef worldStruct = getStruct("World");
+	StructRef markerStruct = getStruct("TimeMarker");
+	StructRef objectStruct = getStruct("Object");
+	StructRef meshStruct = getStruct("Mesh");
+	StructRef vertStruct = getStruct("MVert");
+	StructRef polyStruct = getStruct("MPoly");
+	StructRef loopStruct = getStruct("MLoop");
+	StructRef uvStruct = getStruct("MLoopUV");
+	StructRef layerStruct = getStruct("CustomDataLayer");
+	StructRef materialStruct = getStruct("Material");
+	StructRef animDataStruct = getStruct("AnimData");
+	StructRef actionStruct = getStruct("bAction");
+	StructRef curveStruct = getStruct("FCurve");
+	StructRef bezTripleStruct = getStruct("BezTriple");
+	unsigned int pointerSize = templateFile.pointerSize;
+
+	//mesh topology, the same for every object
+	unsigned int gridWidth = std::max<unsigned int>(2, ceil(sqrt((double)settings.verticesPerMesh)));
+	unsigned int gridHeight = std::max<unsigned int>(2, (settings.verticesPerMesh + gridWidth - 1) / gridWidth);
+	unsigned int numVertices = gridWidth * gridHeight;
+	unsigned int numPolygons = 0;
+	unsigned int numLoops = 0;
+	forEachPolygon(gridWidth, gridHeight, settings, [&](const unsigned int*, unsigned int count) {
+		numPolygons++;
+		numLoops += count;
+	});
+
+	//the rna paths are stored in blocks of a fixed size so every object takes the same address range
+	const char* rnaPaths[] = {"location", "rotation_euler", "scale"};
+	const unsigned int rnaPathSize = 16;
+	unsigned int numMaterialSlots = std::max<unsigned int>(settings.numMaterials, 2);
+
+	//addresses of the blocks of an object relative to the object's range
+	struct ObjectLayout {
+		unsigned long long base, object, mesh, verts, polys, loops, mats, layers, animData, action;
+		std::vector<unsigned long long> uvs, curves, bezTriples, rnaPaths;
+		unsigned long long size;
+	} layout;
+	unsigned long long next = 0;
+	auto allocate = [&](unsigned long long size) {
+		unsigned long long address = next;
+		next += alignAddress(size);
+		return address;
+	};
+	layout.base = allocate(baseStruct.size);
+	layout.object = allocate(objectStruct.size);
+	layout.mesh = allocate(meshStruct.size);
+	layout.verts = allocate((unsigned long long)vertStruct.size * numVertices);
+	layout.polys = allocate((unsigned long long)polyStruct.size * numPolygons);
+	layout.loops = allocate((unsigned long long)loopStruct.size * numLoops);
+	layout.mats = settings.numMaterials > 0 ? allocate(pointerSize * numMaterialSlots) : 0;
+	layout.layers = settings.numUVLayers > 0 ? allocate(layerStruct.size * settings.numUVLayers) : 0;
+	for(unsigned int i=0; i<settings.numUVLayers; i++)
+		layout.uvs.push_back(allocate((unsigned long long)uvStruct.size * numLoops));
+	layout.animData = settings.curvesPerObject > 0 ? allocate(animDataStruct.size) : 0;
+	layout.action = settings.curvesPerObject > 0 ? allocate(actionStruct.size) : 0;
+	for(unsigned int i=0; i<settings.curvesPerObject; i++) {
+		layout.curves.push_back(allocate(curveStruct.size));
+		layout.bezTriples.push_back(allocate((unsigned long long)bezTripleStruct.size * settings.keyframesPerCurve));
+		layout.rnaPaths.push_back(allocate(rnaPathSize));
+	}
+	layout.size = next;
+
+	//addresses of the scene, world, markers and materials come first, followed by the objects
+	next = 0x100000;
+	unsigned long long sceneAddress = allocate(sceneStruct.size);
+	unsigned long long worldAddress = allocate(worldStruct.size);
+	std::vector<unsigned long long> markerAddresses, materialAddresses;
+	for(unsigned int i=0; i<settings.numMarkers; i++)
+		markerAddresses.push_back(allocate(markerStruct.size));
+	for(unsigned int i=0; i<settings.numMaterials; i++)
+		materialAddresses.push_back(allocate(materialStruct.size));
+	unsigned long long objectsStart = next;
+	auto getObjectAddress = [&](unsigned int object, unsigned long long relative) {
+		return objectsStart + object * layout.size + relative;
+	};
+	if(pointerSize == 4 && getObjectAddress(settings.numObjects, 0) > 0xffffffffULL) {
+		ofLogWarning(OFX_BLENDER) << "BlendWriter: the file does not fit into the address space of a template with 4 byte pointers";
+		return false;
+	}
+
+	//header
+	out << "BLENDER" << (pointerSize == 8 ? '-' : '_') << (isHostLittleEndian() ? 'v' : 'V') << templateFile.version;
+
+	//scene
+	std::vector<char> data(sceneStruct.size, 0);
+	setName(data, "Scene", "id.name", "SCScene");
+	if(settings.numObjects > 0) {
+		setPointer(data, "Scene", "base.first", getObjectAddress(0, layout.base));
+		setPointer(data, "Scene", "base.last", getObjectAddress(settings.numObjects - 1, layout.base));
+	}
+	setPointer(data, "Scene", "world", worldAddress);
+	if(!markerAddresses.empty()) {
+		setPointer(data, "Scene", "markers.first", markerAddresses.front());
+		setPointer(data, "Scene", "markers.last", markerAddresses.back());
+	}
+	unsigned int lastFrame = std::max(std::max(settings.keyframesPerCurve, settings.numMarkers) * FRAME_STEP, 250u);
+	set(data, "Scene", "r.frs_sec", 24);
+	set(data, "Scene", "r.frs_sec_base", 1);
+	set(data, "Scene", "r.sfra", 1);
+	set(data, "Scene", "r.efra", lastFrame);
+	set(data, "Scene", "r.cfra", 1);
+	set(data, "Scene", "lay", 1);
+	writeBlock(out, "SC", data, sceneAddress, sceneStruct.sdnaIndex);
+
+	data.assign(worldStruct.size, 0);
+	setName(data, "World", "id.name", "WOWorld");
+	set(data, "World", "horr", .05);
+	set(data, "World", "horg", .05);
+	set(data, "World", "horb", .05);
+	writeBlock(out, "WO", data, worldAddress, worldStruct.sdnaIndex);
+
+	for(unsigned int i=0; i<settings.numMarkers; i++) {
+		data.assign(markerStruct.size, 0);
+		setPointer(data, "TimeMarker", "next", i + 1 < settings.numMarkers ? markerAddresses[i + 1] : 0);
+		setPointer(data, "TimeMarker", "prev", i > 0 ? markerAddresses[i - 1] : 0);
+		set(data, "TimeMarker", "frame", 1 + i * FRAME_STEP);
+		setName(data, "TimeMarker", "name", "F_" + ofToString(i));
+		writeBlock(out, "DATA", data, markerAddresses[i], markerStruct.sdnaIndex);
+	}
+
+	//the materials are chained through their IDs, the loader walks that list
+	for(unsigned int i=0; i<settings.numMaterials; i++) {
+		data.assign(materialStruct.size, 0);
+		setPointer(data, "Material", "id.next", i + 1 < settings.numMaterials ? materialAddresses[i + 1] : 0);
+		setPointer(data, "Material", "id.prev", i > 0 ? materialAddresses[i - 1] : 0);
+		setName(data, "Material", "id.name", "MAMaterial" + ofToString(i));
+		set(data, "Material", "r", hashToUnit(settings.seed, i * 3));
+		set(data, "Material", "g", hashToUnit(settings.seed, i * 3 + 1));
+		set(data, "Material", "b", hashToUnit(settings.seed, i * 3 + 2));
+		set(data, "Material", "specr", 1);
+		set(data, "Material", "specg", 1);
+		set(data, "Material", "specb", 1);
+		set(data, "Material", "spec", .5);
+		set(data, "Material", "alpha", 1);
+		writeBlock(out, "MA", data, materialAddresses[i], materialStruct.sdnaIndex);
+	}
+
+	//fields written per vertex, polygon, loop and keyframe
+	const FieldRef& vertCo = getField("MVert", "co");
+	const FieldRef& vertNo = getField("MVert", "no");
+	const FieldRef& polyLoopStart = getField("MPoly", "loopstart");
+	const FieldRef& polyTotLoop = getField("MPoly", "totloop");
+	const FieldRef& polyMatNr = getField("MPoly", "mat_nr");
+	const FieldRef& polyFlag = getField("MPoly", "flag");
+	const FieldRef& loopV = getField("MLoop", "v");
+	const FieldRef& uvUv = getField("MLoopUV", "uv");
+	const FieldRef& bezTripleVec = getField("BezTriple", "vec");
+	const FieldRef& bezTripleIpo = getField("BezTriple", "ipo");
+	unsigned int objectsPerRow = std::max<unsigned int>(1, ceil(sqrt((double)settings.numObjects)));
+	unsigned int hierarchyDepth = std::max<unsigned int>(settings.hierarchyDepth, 1);
+
+	for(unsigned int i=0; i<settings.numObjects; i++) {
+		string index = ofToString(i);
+
+		data.assign(baseStruct.size, 0);
+		setPointer(data, "Base", "next", i + 1 < settings.numObjects ? getObjectAddress(i + 1, layout.base) : 0);
+		setPointer(data, "Base", "prev", i > 0 ? getObjectAddress(i - 1, layout.base) : 0);
+		setPointer(data, "Base", "object", getObjectAddress(i, layout.object));
+		set(data, "Base", "lay", 1);
+		writeBlock(out, "DATA", data, getObjectAddress(i, layout.base), baseStruct.sdnaIndex);
+
+		//objects are spread on a grid, obmat is the world transformation with the translation in the last row
+		float x = (i % objectsPerRow) * gridWidth * 1.5f;
+		float y = (i / objectsPerRow) * gridHeight * 1.5f;
+		data.assign(objectStruct.size, 0);
+		setPointer(data, "Object", "id.next", i + 1 < settings.numObjects ? getObjectAddress(i + 1, layout.object) : 0);
+		setPointer(data, "Object", "id.prev", i > 0 ? getObjectAddress(i - 1, layout.object) : 0);
+		setName(data, "Object", "id.name", "OBObject" + index);
+		set(data, "Object", "type", OB_MESH);
+		setPointer(data, "Object", "data", getObjectAddress(i, layout.mesh));
+		if(i % hierarchyDepth != 0)
+			setPointer(data, "Object", "parent", getObjectAddress(i - 1, layout.object));
+		for(unsigned int j=0; j<4; j++)
+			set(data, "Object", "obmat", 1, j * 5);
+		set(data, "Object", "obmat", x, 12);
+		set(data, "Object", "obmat", y, 13);
+		set(data, "Object", "loc", x, 0);
+		set(data, "Object", "loc", y, 1);
+		for(unsigned int j=0; j<3; j++)
+			set(data, "Object", "size", 1, j);
+		set(data, "Object", "lay", 1);
+		if(settings.curvesPerObject > 0)
+			setPointer(data, "Object", "adt", getObjectAddress(i, layout.animData));
+		writeBlock(out, "OB", data, getObjectAddress(i, layout.object), objectStruct.sdnaIndex);
+
+		data.assign(meshStruct.size, 0);
+		setPointer(data, "Mesh", "id.next", i + 1 < settings.numObjects ? getObjectAddress(i + 1, layout.mesh) : 0);
+		setPointer(data, "Mesh", "id.prev", i > 0 ? getObjectAddress(i - 1, layout.mesh) : 0);
+		setName(data, "Mesh", "id.name", "MEMesh" + index);
+		set(data, "Mesh", "totvert", numVertices);
+		set(data, "Mesh", "totpoly", numPolygons);
+		set(data, "Mesh", "totloop", numLoops);
+		setPointer(data, "Mesh", "mvert", getObjectAddress(i, layout.verts));
+		setPointer(data, "Mesh", "mpoly", getObjectAddress(i, layout.polys));
+		setPointer(data, "Mesh", "mloop", getObjectAddress(i, layout.loops));
+		if(settings.numMaterials > 0) {
+			setPointer(data, "Mesh", "mat", getObjectAddress(i, layout.mats));
+			set(data, "Mesh", "totcol", settings.numMaterials);
+		}
+		if(settings.numUVLayers > 0) {
+			setPointer(data, "Mesh", "mloopuv", getObjectAddress(i, layout.uvs[0]));
+			setPointer(data, "Mesh", "ldata.layers", getObjectAddress(i, layout.layers));
+			set(data, "Mesh", "ldata.totlayer", settings.numUVLayers);
+			set(data, "Mesh", "ldata.maxlayer", settings.numUVLayers);
+		}
+		writeBlock(out, "ME", data, getObjectAddress(i, layout.mesh), meshStruct.sdnaIndex);
+
+		//a wavy grid, the phase differs per object
+		writeHeader(out, "DATA", (size_t)vertStruct.size * numVertices, getObjectAddress(i, layout.verts), vertStruct.sdnaIndex, numVertices);
+		{
+			ArrayBlockWriter verts(out, vertStruct.size);
+			for(unsigned int v=0; v<numVertices; v++) {
+				char* vert = verts.add();
+				float vx = v % gridWidth;
+				float vy = v / gridWidth;
+				setValue(vert, vertCo, vx, 0);
+				setValue(vert, vertCo, vy, 1);
+				setValue(vert, vertCo, sin(vx * .5f + i) * .25f, 2);
+				setValue(vert, vertNo, 32767, 2);
+			}
+		}
+
+		writeHeader(out, "DATA", (size_t)polyStruct.size * numPolygons, getObjectAddress(i, layout.polys), polyStruct.sdnaIndex, numPolygons);
+		{
+			ArrayBlockWriter polys(out, polyStruct.size);
+			unsigned int loopStart = 0;
+			unsigned int polyIndex = 0;
+			forEachPolygon(gridWidth, gridHeight, settings, [&](const unsigned int*, unsigned int count) {
+				char* poly = polys.add();
+				setValue(poly, polyLoopStart, loopStart);
+				setValue(poly, polyTotLoop, count);
+				if(settings.numMaterials > 0)
+					setValue(poly, polyMatNr, polyIndex % settings.numMaterials);
+				setValue(poly, polyFlag, ME_SMOOTH);
+				loopStart += count;
+				polyIndex++;
+			});
+		}
+
+		writeHeader(out, "DATA", (size_t)loopStruct.size * numLoops, getObjectAddress(i, layout.loops), loopStruct.sdnaIndex, numLoops);
+		{
+			ArrayBlockWriter loops(out, loopStruct.size);
+			forEachPolygon(gridWidth, gridHeight, settings, [&](const unsigned int* verts, unsigned int count) {
+				for(unsigned int j=0; j<count; j++)
+					setValue(loops.add(), loopV, verts[j]);
+			});
+		}
+
+		//material slots are pointer arrays
+		if(settings.numMaterials > 0) {
+			data.assign(pointerSize * numMaterialSlots, 0);
+			for(unsigned int j=0; j<settings.numMaterials; j++) {
+				if(pointerSize == 4)
+					writeRaw<unsigned int>(&data[j * pointerSize], materialAddresses[j]);
+				else
+					writeRaw<unsigned long long>(&data[j * pointerSize], materialAddresses[j]);
+			}
+			writeBlock(out, "DATA", data, getObjectAddress(i, layout.mats), 0);
+		}
+
+		if(settings.numUVLayers > 0) {
+			data.assign(layerStruct.size * settings.numUVLayers, 0);
+			for(unsigned int j=0; j<settings.numUVLayers; j++) {
+				size_t base = j * layerStruct.size;
+				set(data, "CustomDataLayer", "type", CD_MLOOPUV, 0, base);
+				setName(data, "CustomDataLayer", "name", "UVMap" + ofToString(j), base);
+				setPointer(data, "CustomDataLayer", "data", getObjectAddress(i, layout.uvs[j]), 0, base);
+			}
+			writeBlock(out, "DATA", data, getObjectAddress(i, layout.layers), layerStruct.sdnaIndex, settings.numUVLayers);
+
+			for(unsigned int j=0; j<settings.numUVLayers; j++) {
+				writeHeader(out, "DATA", (size_t)uvStruct.size * numLoops, getObjectAddress(i, layout.uvs[j]), uvStruct.sdnaIndex, numLoops);
+				ArrayBlockWriter uvs(out, uvStruct.size);
+				float offset = j * .1f;
+				forEachPolygon(gridWidth, gridHeight, settings, [&](const unsigned int* verts, unsigned int count) {
+					for(unsigned int k=0; k<count; k++) {
+						char* uv = uvs.add();
+						setValue(uv, uvUv, (verts[k] % gridWidth) / float(gridWidth - 1) + offset, 0);
+						setValue(uv, uvUv, (verts[k] / gridWidth) / float(gridHeight - 1), 1);
+					}
+				});
+			}
+		}
+
+		if(settings.curvesPerObject == 0)
+			continue;
+
+		data.assign(animDataStruct.size, 0);
+		setPointer(data, "AnimData", "action", getObjectAddress(i, layout.action));
+		writeBlock(out, "DATA", data, getObjectAddress(i, layout.animData), animDataStruct.sdnaIndex);
+
+		data.assign(actionStruct.size, 0);
+		setName(data, "bAction", "id.name", "ACAction" + index);
+		setPointer(data, "bAction", "curves.first", getObjectAddress(i, layout.curves.front()));
+		setPointer(data, "bAction", "curves.last", getObjectAddress(i, layout.curves.back()));
+		writeBlock(out, "AC", data, getObjectAddress(i, layout.action), actionStruct.sdnaIndex);
+
+		for(unsigned int c=0; c<settings.curvesPerObject; c++) {
+			data.assign(curveStruct.size, 0);
+			setPointer(data, "FCurve", "next", c + 1 < settings.curvesPerObject ? getObjectAddress(i, layout.curves[c + 1]) : 0);
+			setPointer(data, "FCurve", "prev", c > 0 ? getObjectAddress(i, layout.curves[c - 1]) : 0);
+			if(settings.keyframesPerCurve > 0)
+				setPointer(data, "FCurve", "bezt", getObjectAddress(i, layout.bezTriples[c]));
+			set(data, "FCurve", "totvert", settings.keyframesPerCurve);
+			setPointer(data, "FCurve", "rna_path", getObjectAddress(i, layout.rnaPaths[c]));
+			set(data, "FCurve", "array_index", c % 3);
+			writeBlock(out, "DATA", data, getObjectAddress(i, layout.curves[c]), curveStruct.sdnaIndex);
+
+			if(settings.keyframesPerCurve > 0) {
+				writeHeader(out, "DATA", (size_t)bezTripleStruct.size * settings.keyframesPerCurve, getObjectAddress(i, layout.bezTriples[c]), bezTripleStruct.sdnaIndex, settings.keyframesPerCurve);
+				ArrayBlockWriter bezTriples(out, bezTripleStruct.size);
+				for(unsigned int k=0; k<settings.keyframesPerCurve; k++) {
+					char* bezTriple = bezTriples.add();
+					float frame = 1 + k * FRAME_STEP;
+					float value = sin(k + c + i * .1f);
+					//vec holds the left handle, the keyframe and the right handle
+					for(unsigned int h=0; h<3; h++) {
+						setValue(bezTriple, bezTripleVec, frame + (h - 1.f) * FRAME_STEP / 3.f, h * 3);
+						setValue(bezTriple, bezTripleVec, value, h * 3 + 1);
+					}
+					setValue(bezTriple, bezTripleIpo, BEZT_IPO_BEZ);
+				}
+			}
+
+			data.assign(rnaPathSize, 0);
+			const char* rnaPath = rnaPaths[(c / 3) % 3];
+			memcpy(&data[0], rnaPath, strlen(rnaPath));
+			writeBlock(out, "DATA", data, getObjectAddress(i, layout.rnaPaths[c]), 0);
+		}
+	}
+
+	//the catalog of the template and the end marker
+	writeHeader(out, "DNA1", dna.size(), 0, 0, 1);
+	out.write(&dna[0], dna.size());
+	writeHeader(out, "ENDB", 0, 0, 0, 0);
+
+	numBytesWritten = out.tellp();
+	if(!out) {
+		ofLogWarning(OFX_BLENDER) << "BlendWriter: writing \"" << path << "\" failed";
+		return false;
+	}
+	return true;
+}
+
+}
+}
@@ -0,0 +1,93 @@
+#ifndef BLENDWRITER_H
+#define BLENDWRITER_H
+
+#include "File.h"
+
+namespace ofx {
+namespace blender {
+
+//writes synthetic blend files for scaling tests: one scene with a grid mesh per object, materials, uv layers,
+//f-curves and markers. the structures are laid out with the DNA catalog of a template file whose DNA1 block is
+//copied, so the result can be read by any loader that understands the template's blender version, e.g.
+//
+//	BlendWriter writer;
+//	writer.setTemplate("test.blend");
+//	BlendWriter::Settings settings;
+//	settings.numObjects = 100000;
+//	writer.write("large.blend", settings);
+class BlendWriter {
+public:
+	struct Settings {
+		Settings();
+
+		unsigned int numObjects;
+		//length of the parent chains, 1 writes no parents
+		unsigned int hierarchyDepth;
+		//rounded up to a full grid
+		unsigned int verticesPerMesh;
+		//relative amount of triangles, quads and ngons (6 vertices spanning two grid cells) among the polygons
+		float triangles;
+		float quads;
+		float ngons;
+		unsigned int numUVLayers;
+		//shared by all meshes, the polygons cycle through them
+		unsigned int numMaterials;
+		//location, rotation and scale channels, repeated if there are more than 9
+		unsigned int curvesPerObject;
+		unsigned int keyframesPerCurve;
+		unsigned int numMarkers;
+		unsigned int seed;
+	};
+
+	BlendWriter();
+
+	//the template has to be stored in the byte order of this machine and contain the structures of blender 2.6 / 2.7
+	bool setTemplate(string path);
+	bool write(string path, const Settings& settings);
+	//size of the last written file
+	unsigned long long getNumBytesWritten();
+
+private:
+	BlendWriter(const BlendWriter&);
+	BlendWriter& operator=(const BlendWriter&);
+
+	enum ValueType {
+		CHAR, UCHAR, SHORT, USHORT, INT, FLOAT, DOUBLE, INT64, POINTER, UNSUPPORTED
+	};
+
+	//location of a field within a structure, nested structures are resolved to the outer one
+	struct FieldRef {
+		FieldRef():offset(0), size(0), type(UNSUPPORTED) {}
+		unsigned int offset;
+		//size of one element of arrays
+		unsigned int size;
+		ValueType type;
+	};
+
+	struct StructRef {
+		int sdnaIndex;
+		unsigned int size;
+	};
+
+	//path is a field name or nested fields separated by dots, e.g. "r.efra" in Scene
+	const FieldRef& getField(const string& structName, const string& path);
+	StructRef getStruct(const string& structName);
+	void set(std::vector<char>& data, const string& structName, const string& path, double value, unsigned int index=0, size_t base=0);
+	void setPointer(std::vector<char>& data, const string& structName, const string& path, unsigned long long address, unsigned int index=0, size_t base=0);
+	void setName(std::vector<char>& data, const string& structName, const string& path, const string& name, size_t base=0);
+	void setValue(char* data, const FieldRef& field, double value, unsigned int index=0);
+	void setPointerValue(char* data, const FieldRef& field, unsigned long long address, unsigned int index=0);
+	void writeHeader(std::ostream& out, const string& code, size_t size, unsigned long long address, int sdnaIndex, unsigned int count);
+	void writeBlock(std::ostream& out, const string& code, const std::vector<char>& data, unsigned long long address, int sdnaIndex, unsigned int count=1);
+
+	File templateFile;
+	bool hasTemplate;
+	std::vector<char> dna;
+	std::unordered_map<std::string, FieldRef> fields;
+	unsigned long long numBytesWritten;
+};
+
+}
+}
+
+#endif // BLENDWRITER_H
@@ -0,0 +1,138 @@
+#ifndef BLENDER_BYTEORDER_H
+#define BLENDER_BYTEORDER_H
+
+#include <cstring>
+#include <stdint.h>
+#include <utility>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define OFX_BLENDER_SSSE3
+#endif
+
+namespace ofx {
+namespace blender {
+
+//the four layouts a blend file can have, picked once per file from the header
+enum FileLayout {
+	LAYOUT_32_NATIVE,
+	LAYOUT_64_NATIVE,
+	LAYOUT_32_SWAPPED,
+	LAYOUT_64_SWAPPED
+};
+
+inline bool isHostLittleEndian() {
+	const uint16_t probe = 1;
+	return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+inline FileLayout getFileLayout(unsigned int pointerSize, bool littleEndian) {
+	bool swapped = littleEndian != isHostLittleEndian();
+	if(pointerSize == 4)
+		return swapped ? LAYOUT_32_SWAPPED : LAYOUT_32_NATIVE;
+	return swapped ? LAYOUT_64_SWAPPED : LAYOUT_64_NATIVE;
+}
+
+//reverses the bytes of count consecutive values of Size bytes in place
+template<size_t Size>
+struct ByteSwap {
+	static void apply(char* data, size_t count) {
+		for(size_t i=0; i<count; i++) {
+			char* value = data + i * Size;
+			for(size_t j=0; j<Size/2; j++) {
+				char temp = value[j];
+				value[j] = value[Size - 1 - j];
+				value[Size - 1 - j] = temp;
+			}
+		}
+	}
+};
+
+template<>
+struct ByteSwap<1> {
+	static void apply(char*, size_t) {}
+};
+
+#ifdef OFX_BLENDER_SSSE3
+//swap 16 bytes at a time with a shuffle, the rest is done by the scalar loop
+template<size_t Size>
+inline size_t swapBytesSSSE3(char* data, size_t count) {
+	static_assert(Size == 2 || Size == 4 || Size == 8, "unsupported size");
+	const __m128i mask = Size == 2 ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+		Size == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+		_mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+	size_t numBytes = count * Size;
+	size_t i = 0;
+	for(; i + 16 <= numBytes; i += 16) {
+		__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_shuffle_epi8(values, mask));
+	}
+	return i / Size;
+}
+
+template<>
+struct ByteSwap<2> {
+	static void apply(char* data, size_t count) {
+		size_t done = swapBytesSSSE3<2>(data, count);
+		for(size_t i=done; i<count; i++) {
+			std::swap(data[i*2], data[i*2+1]);
+		}
+	}
+};
+
+template<>
+struct ByteSwap<4> {
+	static void apply(char* data, size_t count) {
+		size_t done = swapBytesSSSE3<4>(data, count);
+		for(size_t i=done; i<count; i++) {
+			uint32_t value;
+			memcpy(&value, data + i*4, 4);
+			value = (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+			memcpy(data + i*4, &value, 4);
+		}
+	}
+};
+
+template<>
+struct ByteSwap<8> {
+	static void apply(char* data, size_t count) {
+		size_t done = swapBytesSSSE3<8>(data, count);
+		for(size_t i=done; i<count; i++) {
+			char* value = data + i*8;
+			for(size_t j=0; j<4; j++)
+				std::swap(value[j], value[7-j]);
+		}
+	}
+};
+#endif
+
+//decodes values of a file with the given pointer size, Swap is set when the file's byte order differs from the host
+template<unsigned int PointerSize, bool Swap>
+struct Decoder {
+	template<typename Type>
+	static Type value(const char* data) {
+		Type ret;
+		memcpy(&ret, data, sizeof(Type));
+		if(Swap)
+			ByteSwap<sizeof(Type)>::apply(reinterpret_cast<char*>(&ret), 1);
+		return ret;
+	}
+
+	template<typename Type>
+	static void values(const char* data, Type* out, size_t count) {
+		memcpy(out, data, sizeof(Type) * count);
+		if(Swap)
+			ByteSwap<sizeof(Type)>::apply(reinterpret_cast<char*>(out), count);
+	}
+
+	static unsigned long pointer(const char* data) {
+		if(PointerSize == 4)
+			return value<uint32_t>(data);
+		return value<uint64_t>(data);
+	}
+};
+
+}
+}
+
+#endif // BLENDER_BYTEORDER_H
@@ -1,62 +1,379 @@
 #include "File.h"
 #include <fstream>
 #include "Parser.h"
+#include "GeneratedLayout.h"
+#include "LoadHandle.h"
 #include "Poco/InflatingStream.h"
 #include "Poco/StreamCopier.h"
 #include "Poco/TemporaryFile.h"
 #include "Poco/Exception.h"
+#include "Poco/File.h"
+#include <thread>
+#include <atomic>
+#include <set>
+#ifdef OFX_BLENDER_USE_ZSTD
+#include <zstd.h>
+#endif
 
 class file;
 
 namespace ofx {
 namespace blender {
 
-//helpers to navigate within the file
-void align(ifstream& stream) {
-	streamoff pos = stream.tellg();
-	streamoff trim = pos % 4;
-	if(trim != 0)
-		stream.seekg(pos + 4 - trim);
+///////////////////////////////// PARSER HELPER
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////// HANDLES
+FieldHandle::FieldHandle(string structureName, string fieldName): structureName(structureName), fieldName(fieldName) {
+	std::vector<std::pair<std::string, std::string> >& registry = getRegistry();
+	std::pair<std::string, std::string> key(structureName, fieldName);
+	std::vector<std::pair<std::string, std::string> >::iterator it = std::find(registry.begin(), registry.end(), key);
+	slot = it - registry.begin();
+	if(it == registry.end())
+		registry.push_back(key);
 }
 
-///////////////////////////////// PARSER HELPER
+std::vector<std::pair<std::string, std::string> >& FieldHandle::getRegistry() {
+	static std::vector<std::pair<std::string, std::string> > registry;
+	return registry;
+}
+
+StructHandle::StructHandle(string structureName): structureName(structureName) {
+	std::vector<std::string>& registry = getRegistry();
+	std::vector<std::string>::iterator it = std::find(registry.begin(), registry.end(), structureName);
+	slot = it - registry.begin();
+	if(it == registry.end())
+		registry.push_back(structureName);
+}
+
+std::vector<std::string>& StructHandle::getRegistry() {
+	static std::vector<std::string> registry;
+	return registry;
+}
+
+//handles registered after the catalog was built fall back to lookups by name
+void DNACatalog::resolveHandles() {
+	std::vector<std::string>& structRegistry = StructHandle::getRegistry();
+	handleStructureIndices.resize(structRegistry.size());
+	for(unsigned int i=0; i<structRegistry.size(); i++) {
+		handleStructureIndices[i] = getStructureIndex(structRegistry[i]);
+	}
+
+	std::vector<std::pair<std::string, std::string> >& fieldRegistry = FieldHandle::getRegistry();
+	handleStructures.assign(fieldRegistry.size(), NULL);
+	handleFields.assign(fieldRegistry.size(), NULL);
+	for(unsigned int i=0; i<fieldRegistry.size(); i++) {
+		int structureIndex = getStructureIndex(fieldRegistry[i].first);
+		if(structureIndex == -1)
+			continue;
+		DNAStructure& structure = structures[structureIndex];
+		int fieldIndex = structure.getFieldIndex(fieldRegistry[i].second);
+		if(fieldIndex == -1)
+			continue;
+		handleStructures[i] = &structure;
+		handleFields[i] = &structure.fields[fieldIndex];
+	}
+}
 
 
 ////////////////////
 
 File::File() {
+	cursor = 0;
 	scale = 10;
-	skipTextures = false;
+	inflateInMemory = true;
+	useIndexCache = false;
+	parallelParsing = false;
+	numThreads = 0;
+	deferTextureUpload = false;
+	deferMeshBuilds = false;
+	deferObjectSetup = false;
+	idNameOffset = -1;
+	pointerSize = 8;
+	layout = LAYOUT_64_NATIVE;
+	decompressionTime = 0;
+	parseTime = 0;
+	profiling = false;
+	uploadToGpu = true;
+	arena = std::make_shared<Arena>();
 	Parser::init();
 }
 
 File::~File() {
+	std::shared_ptr<LoadHandle> handle = loadHandle.lock();
+	if(handle)
+		handle->detach();
+	unload();
+}
+
+void File::unload() {
+	std::lock_guard<std::mutex> lock(parseMutex);
+	parsedBlocks.clear();
+	preparedObjects.clear();
+	deferredTextures.clear();
+	deferredMeshes.clear();
+	unbuiltMeshes.clear();
+	deferredSetups.clear();
+	//objects still held through getArena() stay alive, the file continues with a fresh arena
+	arena = std::make_shared<Arena>();
 }
 
+std::shared_ptr<Arena> File::getArena() {
+	return arena;
+}
+
+//helpers to navigate within the file
 void File::seek(streamoff to) {
-	file.seekg(to);
+	if(buffer.isOpen())
+		cursor = to;
+	else {
+		profiler.countSeek();
+		file.seekg(to);
+	}
 }
 
-char* File::readChar(streamsize length) {
-	char* data = new char[length];
-	file.read(data, length);
-	return data;
+streamoff File::tell() {
+	if(buffer.isOpen())
+		return cursor;
+	return file.tellg();
+}
+
+bool File::isEnd() {
+	if(buffer.isOpen())
+		return cursor >= buffer.size();
+	return !file.good();
+}
+
+void File::align() {
+	streamoff pos = tell();
+	streamoff trim = pos % 4;
+	if(trim != 0)
+		seek(pos + 4 - trim);
 }
 
 std::string File::readString(streamsize length) {
+	string ret;
 	if(length == 0) { //0 = read until terminated with zero
-		string res = "";
-		char cur = readChar(1)[0];
-		while(cur != '\0') {
-			res += cur;
-			cur = readChar(1)[0];
+		if(buffer.isOpen()) {
+			size_t available = cursor < buffer.size() ? buffer.size() - cursor : 0;
+			const char* start = buffer.getData() + cursor;
+			const char* end = available > 0 ? static_cast<const char*>(memchr(start, '\0', available)) : NULL;
+			size_t stringLength = end ? end - start : available;
+			ret.assign(start, stringLength);
+			cursor += stringLength + (end ? 1 : 0);
+			profiler.countBytes(stringLength + (end ? 1 : 0));
+		} else {
+			std::getline(file, ret, '\0');
+			profiler.countBytes(ret.size() + 1);
+		}
+	} else {
+		ret.resize(length);
+		const char* data = readRaw(&ret[0], length);
+		if(data == NULL) {
+			ret.assign(length, '\0');
+			if(buffer.isOpen())
+				cursor += length;
+		} else if(data != &ret[0]) {
+			ret.assign(data, length);
+		}
+	}
+	return trim(ret);
+}
+
+std::vector<char> File::readCharAt(streamoff offset, streamsize length) {
+	std::vector<char> data(length, 0);
+	if(!readAt<char>(offset, data.data(), length))
+		std::fill(data.begin(), data.end(), 0);
+	return data;
+}
+
+//trims the string and removes the prefix if it starts with it, on the raw bytes so no temporary strings are built
+static std::string makeName(const char* start, size_t length, const string& prefix) {
+	const char* end = start + length;
+	while(start < end && isspace((unsigned char)*start))
+		start++;
+	while(end > start && isspace((unsigned char)*(end - 1)))
+		end--;
+	if(!prefix.empty() && size_t(end - start) >= prefix.size() && prefix.compare(0, prefix.size(), start, prefix.size()) == 0)
+		start += prefix.size();
+	return std::string(start, end - start);
+}
+
+std::string File::readNameAt(streamoff offset, const string& prefix) {
+	if(!buffer.isOpen()) {
+		string value = readStringAt(offset);
+		return makeName(value.data(), value.size(), prefix);
+	}
+	if(offset < 0 || (size_t)offset >= buffer.size())
+		return "";
+	const char* start = buffer.getData() + offset;
+	size_t available = buffer.size() - offset;
+	const char* end = static_cast<const char*>(memchr(start, '\0', available));
+	profiler.countBytes(end ? end - start + 1 : available);
+	return makeName(start, end ? end - start : available, prefix);
+}
+
+std::string File::readStringAt(streamoff offset) {
+	if(!buffer.isOpen()) {
+		seek(offset);
+		return readString();
+	}
+	if(offset < 0 || (size_t)offset >= buffer.size())
+		return "";
+	const char* start = buffer.getData() + offset;
+	size_t available = buffer.size() - offset;
+	const char* end = static_cast<const char*>(memchr(start, '\0', available));
+	profiler.countBytes(end ? end - start + 1 : available);
+	string ret(start, end ? end - start : available);
+	return trim(ret);
+}
+
+std::string File::readIdName(Block* block) {
+	if(block == NULL || idNameOffset == -1)
+		return "";
+	return readNameAt(block->offset + idNameOffset, block->code);
+}
+
+//inflates the gzipped stream into out, sizeHint is the expected size of the uncompressed data
+bool File::inflateGzip(std::vector<char>& out, size_t sizeHint) {
+	Poco::InflatingInputStream inflater(file, Poco::InflatingStreamBuf::STREAM_GZIP);
+
+	const size_t chunkSize = 1 << 20;
+	out.resize(sizeHint > 0 ? sizeHint : chunkSize);
+	size_t pos = 0;
+	try {
+		while(inflater) {
+			if(pos == out.size())
+				out.resize(out.size() + std::max(chunkSize, out.size() / 2));
+			inflater.read(&out[pos], out.size() - pos);
+			pos += inflater.gcount();
 		}
-		return trim(res);
+	} catch(Poco::Exception& e) {
+		ofLogWarning(OFX_BLENDER) << "Could not inflate blend file";
+		out.clear();
+		return false;
+	}
+	out.resize(pos);
+	//a truncated stream just ends early, the trailer then doesn't match what was inflated
+	if(pos == 0 || (sizeHint > 0 && (pos & 0xffffffff) != sizeHint)) {
+		ofLogWarning(OFX_BLENDER) << "Could not inflate blend file, the gzip stream is truncated or corrupt";
+		out.clear();
+		return false;
+	}
+	return true;
+}
+
+#define ZSTD_MAGIC 0xFD2FB528
+#define ZSTD_SKIPPABLE_MAGIC 0x184D2A50
+#define ZSTD_SEEKABLE_MAGIC 0x8F92EAB1
+
+static unsigned int readLittleEndian32(const char* data) {
+	const unsigned char* bytes = (const unsigned char*)data;
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+bool File::isZstd() {
+	char magic[4] = {0, 0, 0, 0};
+	if(buffer.isOpen()) {
+		if(buffer.size() < 4)
+			return false;
+		memcpy(magic, buffer.getData(), 4);
 	} else {
-		string ret = string(readChar(length), length);
-		return trim(ret);
+		file.clear();
+		file.seekg(0);
+		file.read(magic, 4);
+		file.clear();
+	}
+	return readLittleEndian32(magic) == ZSTD_MAGIC;
+}
+
+//decompresses all frames of a zstd file in parallel, the frame sizes come from the seek table of the seekable format
+bool File::decompressZstd(const char* data, size_t size, std::vector<char>& out) {
+#ifdef OFX_BLENDER_USE_ZSTD
+	struct Frame {
+		size_t compressedOffset;
+		size_t compressedSize;
+		size_t offset;
+		size_t size;
+	};
+	std::vector<Frame> frames;
+
+	//the seek table is a skippable frame at the end of the file, it ends with
+	//the number of frames (4 bytes), a descriptor (1 byte) and the seekable magic number (4 bytes)
+	bool hasSeekTable = false;
+	if(size >= 17 && readLittleEndian32(data + size - 4) == ZSTD_SEEKABLE_MAGIC) {
+		size_t numFrames = readLittleEndian32(data + size - 9);
+		size_t entrySize = (data[size - 5] & 0x80) ? 12 : 8;
+		size_t tableSize = 8 + numFrames * entrySize + 9;
+		if(tableSize <= size && (readLittleEndian32(data + size - tableSize) & 0xFFFFFFF0) == ZSTD_SKIPPABLE_MAGIC) {
+			const char* entry = data + size - tableSize + 8;
+			Frame frame = {0, 0, 0, 0};
+			for(size_t i=0; i<numFrames; i++) {
+				frame.compressedSize = readLittleEndian32(entry);
+				frame.size = readLittleEndian32(entry + 4);
+				frames.push_back(frame);
+				frame.compressedOffset += frame.compressedSize;
+				frame.offset += frame.size;
+				entry += entrySize;
+			}
+			hasSeekTable = frame.compressedOffset == size - tableSize;
+		}
+	}
+
+	//without a seek table walk the frames, this only works if they store their content size
+	if(!hasSeekTable) {
+		frames.clear();
+		Frame frame = {0, 0, 0, 0};
+		while(frame.compressedOffset + 8 <= size) {
+			const char* src = data + frame.compressedOffset;
+			if((readLittleEndian32(src) & 0xFFFFFFF0) == ZSTD_SKIPPABLE_MAGIC) {
+				frame.compressedOffset += 8 + readLittleEndian32(src + 4);
+				continue;
+			}
+			frame.compressedSize = ZSTD_findFrameCompressedSize(src, size - frame.compressedOffset);
+			unsigned long long contentSize = ZSTD_getFrameContentSize(src, size - frame.compressedOffset);
+			if(ZSTD_isError(frame.compressedSize) || contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR) {
+				ofLogWarning(OFX_BLENDER) << "Could not determine the frame sizes of the zstd compressed file";
+				return false;
+			}
+			frame.size = contentSize;
+			frames.push_back(frame);
+			frame.compressedOffset += frame.compressedSize;
+			frame.offset += frame.size;
+		}
+	}
+
+	if(frames.empty())
+		return false;
+	out.resize(frames.back().offset + frames.back().size);
+
+	//every thread works with its own decompression context on every nth frame
+	unsigned int numThreads = std::max(1u, std::min((unsigned int)frames.size(), std::thread::hardware_concurrency()));
+	std::atomic<bool> failed(false);
+	parallelFor(numThreads, [&](unsigned int thread) {
+		ZSTD_DCtx* context = ZSTD_createDCtx();
+		for(size_t i=thread; i<frames.size() && !failed; i+=numThreads) {
+			Frame& frame = frames[i];
+			size_t result = ZSTD_decompressDCtx(context, &out[0] + frame.offset, frame.size, data + frame.compressedOffset, frame.compressedSize);
+			if(ZSTD_isError(result) || result != frame.size) {
+				ofLogWarning(OFX_BLENDER) << "Could not decompress zstd frame " << i;
+				failed = true;
+			}
+		}
+		ZSTD_freeDCtx(context);
+	}, numThreads);
+
+	if(failed) {
+		out.clear();
+		return false;
 	}
-	return "";
+	return true;
+#else
+	(void)data;
+	(void)size;
+	(void)out;
+	ofLogWarning(OFX_BLENDER) << "Blend file is zstd compressed, define OFX_BLENDER_USE_ZSTD and link libzstd to load it";
+	return false;
+#endif
 }
 
 void File::readHeader(File::Block& block) {
@@ -75,79 +392,17 @@ void File::readHeader(File::Block& block) {
 		block.address = readPointer();
 		block.SDNAIndex = read<unsigned int>();
 		block.count = read<unsigned int>();
-		block.offset = file.tellg();
+		block.offset = tell();
 	} else {
 		block.size = read<unsigned int>();
 		block.address = 0;
 		block.SDNAIndex = 0;
 		block.count = 0;
-		block.offset = file.tellg();
+		block.offset = tell();
 	}
 }
 
-bool File::load(string path) {
-	//load the blend file into the stream
-	if(file.is_open())
-		file.close();
-	file.open(ofToDataPath(path, true).c_str(), ios::binary);
-	//info should contain blender now, if not it is compressed
-	string info = readString(7);
-
-	//check if the file is gzipped
-	if(info != "BLENDER") {
-		seek(0);
-
-		//unzip the blend file to a temp file and reload
-		Poco::InflatingInputStream inflater(file, Poco::InflatingStreamBuf::STREAM_GZIP);
-
-		Poco::TemporaryFile tempFile;
-		tempFile.keepUntilExit();
-		std::ofstream out(tempFile.path().c_str(), ios::binary);
-		Poco::StreamCopier::copyStream( inflater, out);
-		out.close();
-
-		file.close();
-		file.open(tempFile.path().c_str(), ios::binary);
-		info = readString(7);
-
-		if(info != "BLENDER") {
-			ofLogWarning(OFX_BLENDER) << "Could not read blend file " << path;
-		} else {
-			ofLogVerbose(OFX_BLENDER) << "Blend file is gzipped, temporarily decompressed contents to " << tempFile.path();
-		}
-	}
-
-	//now extract the rest of the header data
-	string tempString = readString(1);
-
-	if(tempString == "-")
-		pointerSize = 8;
-	else if(tempString == "_")
-		pointerSize = 4;
-	//ofLogVerbose(OFX_BLENDER) << "Pointer Size is " << pointerSize;
-
-	if(pointerSize == 4) {
-		readPointer = std::bind(&File::read<unsigned int>, this);
-	} else {
-		readPointer = std::bind(&File::read<unsigned long>, this);
-	}
-
-	bool littleEndianness;
-	char structPre = ' ';
-	tempString = readString(1);
-	if(tempString == "v") {
-		littleEndianness = true;
-		structPre = '<';
-	} else if(tempString == "V") {
-		littleEndianness = false;
-		structPre = '>';
-	}
-	//ofLogVerbose(OFX_BLENDER) << "Struct pre is " << structPre;
-	//ofLogVerbose(OFX_BLENDER) << "Little Endianness is " << littleEndianness;
-
-	//version
-	version = readString(3);
-
+void File::readBlocks() {
 	//now go through all them blocks
 	blocks.push_back(Block(this));
 
@@ -155,15 +410,22 @@ bool File::load(string path) {
 	readHeader(blocks.back());
 
 	while(blocks.back().code != "DNA1" && blocks.back().code != "SDNA") {
+		if(isEnd()) {
+			ofLogWarning(OFX_BLENDER) << "Reached the end of the file without finding the DNA catalog";
+			break;
+		}
 
 		//skip the block data
-		file.seekg(file.tellg() + streamoff(blocks.back().size));
+		seek(tell() + streamoff(blocks.back().size));
 
 		//read a new block
 		blocks.push_back(Block(this));
 		readHeader(blocks.back());
+		progress.bytesRead = tell();
 	}
+}
 
+void File::readCatalog() {
 	//advance
 	readString(4);
 	readString(4);
@@ -173,7 +435,7 @@ bool File::load(string path) {
 	for(unsigned int i=0; i<numNames; i++) {
 		catalog.names.push_back(DNAName(readString(0)));
 	}
-	align(file);
+	align();
 
 	//TYPES
 	readString(4);
@@ -182,7 +444,7 @@ bool File::load(string path) {
 	for(unsigned int i=0; i<numTypes; i++) {
 		catalog.types.push_back(DNAType(readString(0), i));
 	}
-	align(file);
+	align();
 
 	//TYPE LENGTHS
 	readString(4);;
@@ -191,7 +453,7 @@ bool File::load(string path) {
 		if(catalog.types[i].size == 0) //assume it is a pointer
 			catalog.types[i].size = pointerSize;
 	}
-	align(file);
+	align();
 
 	//STRUCTURES
 	readString(4);
@@ -246,99 +508,998 @@ bool File::load(string path) {
 			}
 		}
 	}
-	align(file);
+	align();
+}
+
+bool File::load(string path) {
+	unsigned long long startTime = ofGetElapsedTimeMicros();
+	decompressionTime = 0;
+	progress.reset();
+	profiler.setEnabled(profiling);
+	profiler.reset();
+
+	//map the blend file into memory, if that is not possible read it through a stream
+	if(file.is_open())
+		file.close();
+	buffer.close();
+	cursor = 0;
+	string fullPath = ofToDataPath(path, true);
+	if(!buffer.map(fullPath)) {
+		ofLogVerbose(OFX_BLENDER) << "Could not map \"" << path << "\" into memory, reading from stream";
+		file.open(fullPath.c_str(), ios::binary);
+	}
+	//info should contain blender now, if not it is compressed
+	string info = readString(7);
+
+	//check if the file is compressed with zstd (blender 3.0+)
+	if(info != "BLENDER" && isZstd()) {
+		Profiler::PhaseScope scope(profiler, LoadProfile::INFLATE);
+		std::vector<char> compressed;
+		const char* data = buffer.getData();
+		size_t size = buffer.size();
+		if(!buffer.isOpen()) {
+			file.seekg(0, ios::end);
+			compressed.resize(file.tellg());
+			file.seekg(0);
+			file.read(&compressed[0], compressed.size());
+			file.close();
+			data = &compressed[0];
+			size = compressed.size();
+		}
+
+		std::vector<char> decompressed;
+		bool isDecompressed = decompressZstd(data, size, decompressed);
+		if(!isDecompressed) {
+			ofLogWarning(OFX_BLENDER) << "Could not decompress blend file " << path;
+			buffer.close();
+			return false;
+		}
+		buffer.assign(decompressed);
+		cursor = 0;
+		info = readString(7);
+
+		if(info != "BLENDER") {
+			ofLogWarning(OFX_BLENDER) << "Could not read blend file " << path;
+			return false;
+		}
+		ofLogVerbose(OFX_BLENDER) << "Blend file is zstd compressed, decompressed " << buffer.size() << " bytes into memory";
+		decompressionTime = (ofGetElapsedTimeMicros() - startTime) / 1000.f;
+	}
+
+	//check if the file is gzipped
+	if(info != "BLENDER") {
+		Profiler::PhaseScope scope(profiler, LoadProfile::INFLATE);
+		//the inflater works on streams
+		buffer.close();
+		if(!file.is_open())
+			file.open(fullPath.c_str(), ios::binary);
+
+		if(inflateInMemory) {
+			//the gzip trailer holds the uncompressed size (modulo 2^32)
+			unsigned char trailer[4] = {0, 0, 0, 0};
+			file.seekg(-4, ios::end);
+			file.read((char*)trailer, 4);
+			size_t sizeHint = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((size_t)trailer[3] << 24);
+			file.clear();
+			file.seekg(0);
+
+			std::vector<char> inflated;
+			bool isInflated = inflateGzip(inflated, sizeHint);
+			file.close();
+			if(!isInflated)
+				return false;
+			buffer.assign(inflated);
+			cursor = 0;
+			info = readString(7);
+
+			if(info != "BLENDER") {
+				ofLogWarning(OFX_BLENDER) << "Could not read blend file " << path;
+				return false;
+			}
+			ofLogVerbose(OFX_BLENDER) << "Blend file is gzipped, decompressed " << buffer.size() << " bytes into memory";
+		} else {
+			seek(0);
+
+			//unzip the blend file to a temp file and reload
+			Poco::InflatingInputStream inflater(file, Poco::InflatingStreamBuf::STREAM_GZIP);
+
+			Poco::TemporaryFile tempFile;
+			tempFile.keepUntilExit();
+			std::ofstream out(tempFile.path().c_str(), ios::binary);
+			try {
+				Poco::StreamCopier::copyStream( inflater, out);
+			} catch(Poco::Exception& e) {
+				ofLogWarning(OFX_BLENDER) << "Could not inflate blend file";
+				file.close();
+				return false;
+			}
+			out.close();
+
+			file.close();
+			cursor = 0;
+			if(!buffer.map(tempFile.path()))
+				file.open(tempFile.path().c_str(), ios::binary);
+			info = readString(7);
+
+			if(info != "BLENDER") {
+				ofLogWarning(OFX_BLENDER) << "Could not read blend file " << path;
+				return false;
+			}
+			ofLogVerbose(OFX_BLENDER) << "Blend file is gzipped, temporarily decompressed contents to " << tempFile.path();
+		}
+		decompressionTime = (ofGetElapsedTimeMicros() - startTime) / 1000.f;
+	}
+
+	progress.bytesTotal = buffer.isOpen() ? buffer.size() : 0;
+	if(!buffer.isOpen() && file.is_open()) {
+		streamoff start = file.tellg();
+		file.seekg(0, ios::end);
+		progress.bytesTotal = file.tellg();
+		file.seekg(start);
+	}
+
+	//now extract the rest of the header data
+	string tempString = readString(1);
+
+	if(tempString == "-")
+		pointerSize = 8;
+	else if(tempString == "_")
+		pointerSize = 4;
+	//ofLogVerbose(OFX_BLENDER) << "Pointer Size is " << pointerSize;
+
+	bool littleEndianness = true;
+	char structPre = ' ';
+	tempString = readString(1);
+	if(tempString == "v") {
+		littleEndianness = true;
+		structPre = '<';
+	} else if(tempString == "V") {
+		littleEndianness = false;
+		structPre = '>';
+	}
+	//ofLogVerbose(OFX_BLENDER) << "Struct pre is " << structPre;
+	//ofLogVerbose(OFX_BLENDER) << "Little Endianness is " << littleEndianness;
+
+	//pick the decoder for pointer size and byte order once, everything after the header is read through it
+	layout = getFileLayout(pointerSize, littleEndianness);
+	if(!littleEndianness)
+		ofLogVerbose(OFX_BLENDER) << "Blend file is big endian, values are byte swapped while reading";
+
+	//version
+	version = readString(3);
+
+	//reset everything from a previous load
+	unload();
+	blocks.clear();
+	catalog = DNACatalog();
+
+	//the block headers and the DNA catalog can be restored from the index cache
+	bool isCached = false;
+	string cachePath;
+	IndexCacheKey cacheKey;
+	if(useIndexCache) {
+		Profiler::PhaseScope scope(profiler, LoadProfile::HEADER_SCAN);
+		cachePath = getIndexCachePath(fullPath);
+		cacheKey = createIndexCacheKey(fullPath);
+		isCached = readIndexCache(cachePath, cacheKey, getReachableRoots());
+		if(isCached)
+			ofLogVerbose(OFX_BLENDER) << "Restored block index from " << cachePath;
+	}
+
+	if(!isCached) {
+		{
+			Profiler::PhaseScope scope(profiler, LoadProfile::HEADER_SCAN);
+			readBlocks();
+		}
+		Profiler::PhaseScope scope(profiler, LoadProfile::DNA_PARSE);
+		readCatalog();
+	}
+	progress.bytesRead = progress.bytesTotal.load();
+
+	{
+		Profiler::PhaseScope scope(profiler, LoadProfile::INDEX_BUILD);
+
+		//now link all structures with the File Blocks
+		vector<Block>::iterator it = blocks.begin();
+		while(it != blocks.end()) {
+			(*it).structure = &catalog.structures[(*it).SDNAIndex];
+			it++;
+		}
 
-	//now link all structures with the File Blocks
-	vector<Block>::iterator it = blocks.begin();
-	while(it != blocks.end()) {
-		(*it).structure = &catalog.structures[(*it).SDNAIndex];
-		it++;
+		catalog.buildIndex();
+		buildAddressIndex();
+		buildTypeIndex();
+		if(!isCached) {
+			if(filter.reachableOnly)
+				removeUnreachableBlocks();
+			if(useIndexCache)
+				writeIndexCache(cachePath, cacheKey, getReachableRoots());
+		}
+		validateLayouts();
 	}
 
+	parseTime = (ofGetElapsedTimeMicros() - startTime) / 1000.f - decompressionTime;
+
 	ofLogVerbose(OFX_BLENDER) << "Loaded \"" << path << "\" - Blender version is " <<  version;
+	ofLogVerbose(OFX_BLENDER) << "Decompression took " << decompressionTime << "ms, parsing took " << parseTime << "ms";
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////// INDEX CACHE //////////
+#define INDEX_CACHE_MAGIC "OFXBIDX"
+#define INDEX_CACHE_VERSION 3
+
+//the cache is a header, a table of zero terminated strings (version, roots, DNA names and type names) and plain
+//arrays of type sizes, structures, fields and block headers, so every part is read with a single memcpy
+struct IndexCacheHeader {
+	char magic[8];
+	unsigned int version;
+	unsigned int pointerSize;
+	unsigned long long fileSize;
+	long long modified;
+	unsigned long long hash;
+	unsigned int stringBytes;
+	unsigned int numNames;
+	unsigned int numTypes;
+	unsigned int numStructures;
+	unsigned int numFields;
+	unsigned int numBlocks;
+};
+
+struct IndexCacheStructure {
+	unsigned short type;
+	unsigned short numFields;
+};
+
+struct IndexCacheField {
+	unsigned short type;
+	unsigned short name;
+	unsigned int offset;
+};
+
+struct IndexCacheBlock {
+	char code[4];
+	unsigned int size;
+	unsigned long long address;
+	unsigned int SDNAIndex;
+	unsigned int count;
+	long long offset;
+};
+
+//FNV-1a
+static unsigned long long hashBytes(const char* data, size_t length, unsigned long long hash=14695981039346656037ULL) {
+	for(size_t i=0; i<length; i++) {
+		hash ^= (unsigned char)data[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+//copies count values from data at offset and moves the offset on, false if the data is too short
+template<typename Type>
+static bool readCacheArray(const char* data, size_t size, size_t& offset, std::vector<Type>& values, size_t count) {
+	if(offset > size || count > (size - offset) / sizeof(Type))
+		return false;
+	values.resize(count);
+	if(count > 0)
+		memcpy(&values[0], data + offset, count * sizeof(Type));
+	offset += count * sizeof(Type);
+	return true;
+}
+
+template<typename Type>
+static void writeCacheArray(std::ostream& out, const std::vector<Type>& values) {
+	if(!values.empty())
+		out.write((const char*)&values[0], values.size() * sizeof(Type));
+}
+
+string File::getIndexCachePath(string blendPath) {
+	if(indexCacheDirectory.empty())
+		return blendPath + ".index";
+	return ofFilePath::join(ofToDataPath(indexCacheDirectory, true), ofFilePath::getFileName(blendPath) + ".index");
+}
+
+//the cache is valid as long as size, modification time and the first and last KB of the file did not change
+File::IndexCacheKey File::createIndexCacheKey(string blendPath) {
+	IndexCacheKey key;
+	Poco::File info(blendPath);
+	key.fileSize = info.getSize();
+	key.modified = info.getLastModified().epochMicroseconds();
+
+	std::ifstream in(blendPath.c_str(), ios::binary);
+	size_t length = std::min<unsigned long long>(1024, key.fileSize);
+	std::vector<char> bytes(length + 1);
+	in.read(&bytes[0], length);
+	key.hash = hashBytes(&bytes[0], length);
+	in.seekg(key.fileSize - length);
+	in.read(&bytes[0], length);
+	key.hash = hashBytes(&bytes[0], length, key.hash);
+	return key;
+}
+
+bool File::readIndexCache(string cachePath, IndexCacheKey key, string roots) {
+	FileBuffer cache;
+	if(!cache.map(cachePath))
+		return false;
+	const char* data = cache.getData();
+	size_t size = cache.size();
+
+	IndexCacheHeader header;
+	if(size < sizeof(header))
+		return false;
+	memcpy(&header, data, sizeof(header));
+	if(string(header.magic, 7) != INDEX_CACHE_MAGIC || header.version != INDEX_CACHE_VERSION)
+		return false;
+	if(header.fileSize != key.fileSize || header.modified != key.modified || header.hash != key.hash || header.pointerSize != pointerSize)
+		return false;
+
+	//strings: version, roots, names and types
+	size_t offset = sizeof(header);
+	std::vector<char> stringTable;
+	std::vector<unsigned short> typeSizes;
+	std::vector<IndexCacheStructure> structures;
+	std::vector<IndexCacheField> fields;
+	std::vector<IndexCacheBlock> cachedBlocks;
+	bool isValid = readCacheArray(data, size, offset, stringTable, header.stringBytes)
+		&& readCacheArray(data, size, offset, typeSizes, header.numTypes)
+		&& readCacheArray(data, size, offset, structures, header.numStructures)
+		&& readCacheArray(data, size, offset, fields, header.numFields)
+		&& readCacheArray(data, size, offset, cachedBlocks, header.numBlocks);
+
+	std::vector<string> strings;
+	for(size_t start=0, end=0; isValid && end<stringTable.size(); end++) {
+		if(stringTable[end] == 0) {
+			strings.push_back(string(&stringTable[start], end - start));
+			start = end + 1;
+		}
+	}
+	isValid = isValid && strings.size() == 2 + header.numNames + header.numTypes;
+	if(!isValid) {
+		ofLogWarning(OFX_BLENDER) << "Index cache " << cachePath << " is corrupt, rebuilding";
+		return false;
+	}
+	if(strings[0] != version)
+		return false;
+	//blocks of a cache written with a reduced block list only fit the same roots
+	if(strings[1] != roots)
+		return false;
+
+	//DNA catalog
+	catalog.names.reserve(header.numNames);
+	for(unsigned int i=0; i<header.numNames; i++)
+		catalog.names.push_back(DNAName(strings[2 + i]));
+	catalog.types.reserve(header.numTypes);
+	for(unsigned int i=0; i<header.numTypes; i++) {
+		catalog.types.push_back(DNAType(strings[2 + header.numNames + i], i));
+		catalog.types.back().size = typeSizes[i];
+	}
+	catalog.structures.reserve(structures.size());
+	size_t field = 0;
+	for(IndexCacheStructure& cached: structures) {
+		if(cached.type >= catalog.types.size() || cached.numFields > fields.size() - field)
+			break;
+		catalog.structures.push_back(DNAStructure(&catalog.types[cached.type]));
+		DNAStructure& structure = catalog.structures.back();
+		structure.fields.reserve(cached.numFields);
+		for(unsigned int i=0; i<cached.numFields; i++, field++) {
+			if(fields[field].type >= catalog.types.size() || fields[field].name >= catalog.names.size())
+				break;
+			structure.fields.push_back(DNAField(&catalog.types[fields[field].type], &catalog.names[fields[field].name], fields[field].offset));
+		}
+	}
+
+	//block headers
+	blocks.reserve(cachedBlocks.size());
+	for(IndexCacheBlock& cached: cachedBlocks) {
+		if(cached.SDNAIndex >= catalog.structures.size())
+			break;
+		blocks.push_back(Block(this));
+		Block& block = blocks.back();
+		block.code.assign(cached.code, strnlen(cached.code, 4));
+		block.size = cached.size;
+		block.address = cached.address;
+		block.SDNAIndex = cached.SDNAIndex;
+		block.count = cached.count;
+		block.offset = cached.offset;
+	}
 
+	if(blocks.size() != cachedBlocks.size() || catalog.structures.size() != structures.size() || field != fields.size()) {
+		ofLogWarning(OFX_BLENDER) << "Index cache " << cachePath << " is corrupt, rebuilding";
+		blocks.clear();
+		catalog = DNACatalog();
+		return false;
+	}
 	return true;
 }
 
+void File::writeIndexCache(string cachePath, IndexCacheKey key, string roots) {
+	std::ofstream out(cachePath.c_str(), ios::binary);
+	if(!out.is_open()) {
+		ofLogWarning(OFX_BLENDER) << "Could not write index cache " << cachePath;
+		return;
+	}
+
+	std::vector<char> stringTable;
+	auto addString = [&](const string& value) {
+		stringTable.insert(stringTable.end(), value.begin(), value.end());
+		stringTable.push_back(0);
+	};
+	addString(version);
+	addString(roots);
+	for(DNAName& name: catalog.names)
+		addString(name.name);
+	for(DNAType& type: catalog.types)
+		addString(type.name);
+
+	//DNA catalog, fields reference types and names by index
+	std::vector<unsigned short> typeSizes;
+	for(DNAType& type: catalog.types)
+		typeSizes.push_back(type.size);
+	std::vector<IndexCacheStructure> structures;
+	std::vector<IndexCacheField> fields;
+	for(DNAStructure& structure: catalog.structures) {
+		IndexCacheStructure cached;
+		cached.type = structure.type - &catalog.types[0];
+		cached.numFields = structure.fields.size();
+		structures.push_back(cached);
+		for(DNAField& field: structure.fields) {
+			IndexCacheField cachedField;
+			cachedField.type = field.type - &catalog.types[0];
+			cachedField.name = field.name - &catalog.names[0];
+			cachedField.offset = field.offset;
+			fields.push_back(cachedField);
+		}
+	}
+
+	std::vector<IndexCacheBlock> cachedBlocks(blocks.size());
+	for(size_t i=0; i<blocks.size(); i++) {
+		Block& block = blocks[i];
+		IndexCacheBlock& cached = cachedBlocks[i];
+		memset(cached.code, 0, 4);
+		memcpy(cached.code, block.code.data(), std::min<size_t>(4, block.code.size()));
+		cached.size = block.size;
+		cached.address = block.address;
+		cached.SDNAIndex = block.SDNAIndex;
+		cached.count = block.count;
+		cached.offset = block.offset;
+	}
+
+	IndexCacheHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, INDEX_CACHE_MAGIC, 8);
+	header.version = INDEX_CACHE_VERSION;
+	header.pointerSize = pointerSize;
+	header.fileSize = key.fileSize;
+	header.modified = key.modified;
+	header.hash = key.hash;
+	header.stringBytes = stringTable.size();
+	header.numNames = catalog.names.size();
+	header.numTypes = catalog.types.size();
+	header.numStructures = structures.size();
+	header.numFields = fields.size();
+	header.numBlocks = cachedBlocks.size();
+
+	out.write((const char*)&header, sizeof(header));
+	writeCacheArray(out, stringTable);
+	writeCacheArray(out, typeSizes);
+	writeCacheArray(out, structures);
+	writeCacheArray(out, fields);
+	writeCacheArray(out, cachedBlocks);
+
+	if(!out)
+		ofLogWarning(OFX_BLENDER) << "Could not write index cache " << cachePath;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////
 
 void* File::parseFileBlock(Block* block) {
 	//check loopkup table
 	if(block == NULL)
 		return NULL;
-	if(parsedBlocks.find(block->address) == parsedBlocks.end()) {
-		parsedBlocks[block->address] = Parser::parseFileBlock(block);
+
+	//blocks can be requested from several threads, the first one parses and the others wait for the result
+	std::unique_lock<std::mutex> lock(parseMutex);
+	while(true) {
+		std::map<unsigned long, void*>::iterator it = parsedBlocks.find(block->address);
+		if(it != parsedBlocks.end()) {
+			profiler.countCacheHit();
+			return it->second;
+		}
+		std::map<unsigned long, std::thread::id>::iterator parsing = parsingBlocks.find(block->address);
+		if(parsing == parsingBlocks.end())
+			break;
+		if(parsing->second == std::this_thread::get_id()) {
+			ofLogWarning(OFX_BLENDER) << "Block " << block->code << " references itself while being parsed";
+			return NULL;
+		}
+		parseDone.wait(lock);
+	}
+	parsingBlocks[block->address] = std::this_thread::get_id();
+	lock.unlock();
+	profiler.countCacheMiss();
+
+	void* parsed = Parser::parseFileBlock(block);
+
+	lock.lock();
+	parsingBlocks.erase(block->address);
+	parsedBlocks[block->address] = parsed;
+	progress.blocksParsed++;
+	parseDone.notify_all();
+	return parsed;
+}
+
+Scene* File::parseScene(Block* block, bool uploadNow) {
+	if(block != NULL && (parallelParsing || !uploadNow))
+		prepareScene(block, uploadNow);
+	deferMeshBuilds = true;
+	deferTextureUpload = !uploadNow;
+	deferObjectSetup = !uploadNow;
+	Scene* scene = static_cast<Scene*>(parseFileBlock(block));
+	deferMeshBuilds = false;
+	deferTextureUpload = false;
+	deferObjectSetup = false;
+	buildAll();
+
+	//meshes that were not prepared ahead (e.g. the file is not in memory) are queued as well
+	if(!uploadNow && scene != NULL && uploadToGpu) {
+		std::lock_guard<std::mutex> lock(parseMutex);
+		std::set<Mesh*> queued(deferredMeshes.begin(), deferredMeshes.end());
+		for(Mesh* mesh: scene->getMeshes()) {
+			if(queued.insert(mesh).second)
+				deferredMeshes.push_back(mesh);
+		}
+	}
+	return scene;
+}
+
+//textures, materials and mesh data of a scene are independent of the scene graph and parsed on worker threads,
+//the objects are linked afterwards on the calling thread
+void File::prepareScene(Block* block, bool uploadNow) {
+	{
+		std::lock_guard<std::mutex> lock(parseMutex);
+		if(parsedBlocks.find(block->address) != parsedBlocks.end())
+			return;
+	}
+	if(!buffer.isOpen()) {
+		ofLogVerbose(OFX_BLENDER) << "File is not in memory, parsing on a single thread";
+		return;
+	}
+
+	std::vector<Block*> objects, materials, textures;
+	Parser::collectSceneBlocks(block, objects, materials, textures);
+	progress.meshesTotal = objects.size();
+
+	//textures can't be uploaded from the workers, they are loaded into pixels and uploaded at the end
+	deferTextureUpload = true;
+	deferMeshBuilds = true;
+
+	{
+		Profiler::PhaseScope scope(profiler, LoadProfile::TEXTURE_DECODE);
+		parallelFor(textures.size(), [&](unsigned int i) {
+			parseFileBlock(textures[i]);
+		}, numThreads);
+	}
+
+	parallelFor(materials.size(), [&](unsigned int i) {
+		parseFileBlock(materials[i]);
+	}, numThreads);
+
+	std::vector<Object*> parsedObjects(objects.size(), NULL);
+	parallelFor(objects.size(), [&](unsigned int i) {
+		parsedObjects[i] = Parser::parseObjectData(objects[i]);
+	}, numThreads);
+
+	deferTextureUpload = false;
+	deferMeshBuilds = false;
+
+	//the meshes are built once all are parsed, a few large ones don't hold up the rest of the workers
+	buildAll();
+
+	{
+		std::lock_guard<std::mutex> lock(parseMutex);
+		for(unsigned int i=0; i<objects.size(); i++) {
+			if(!parsedObjects[i])
+				continue;
+			preparedObjects[objects[i]->address] = parsedObjects[i];
+			if(parsedObjects[i]->type == MESH && uploadToGpu)
+				deferredMeshes.push_back(static_cast<Mesh*>(parsedObjects[i]));
+		}
+	}
+
+	if(uploadNow) {
+		while(uploadNext());
+	}
+}
+
+bool File::uploadNext() {
+	if(!deferredSetups.empty()) {
+		std::pair<Block*, Object*> setup = deferredSetups.back();
+		deferredSetups.pop_back();
+		Parser::parseObjectData(setup.first, setup.second);
+		return true;
+	}
+	if(!deferredTextures.empty()) {
+		Texture* texture = deferredTextures.back();
+		deferredTextures.pop_back();
+		texture->img.setUseTexture(true);
+		texture->img.update();
+		return true;
 	}
-	return parsedBlocks[block->address];
+	if(!deferredMeshes.empty()) {
+		Mesh* mesh = deferredMeshes.back();
+		deferredMeshes.pop_back();
+		mesh->upload();
+		return true;
+	}
+	return false;
+}
+
+void File::deferTexture(Texture* texture) {
+	std::lock_guard<std::mutex> lock(parseMutex);
+	deferredTextures.push_back(texture);
+}
+
+void File::deferMeshBuild(Mesh* mesh) {
+	std::lock_guard<std::mutex> lock(parseMutex);
+	unbuiltMeshes.push_back(mesh);
+}
+
+void File::deferSetup(Block* block, Object* object) {
+	std::lock_guard<std::mutex> lock(parseMutex);
+	deferredSetups.push_back(std::make_pair(block, object));
+}
+
+void File::buildAll() {
+	std::vector<Mesh*> meshes;
+	{
+		std::lock_guard<std::mutex> lock(parseMutex);
+		meshes.swap(unbuiltMeshes);
+	}
+	if(meshes.empty())
+		return;
+	//without prepareScene nothing counted the meshes yet
+	if(progress.meshesTotal < progress.meshesBuilt + meshes.size())
+		progress.meshesTotal = progress.meshesBuilt + meshes.size();
+
+	Profiler::PhaseScope scope(profiler, LoadProfile::MESH_BUILD);
+	Mesh::buildAll(meshes, numThreads, [&](Mesh* mesh) {
+		Profiler::WorkScope work(profiler, LoadProfile::MESH_BUILD);
+		mesh->build();
+		progress.meshesBuilt++;
+	});
+}
+
+Object* File::takePreparedObject(unsigned long address) {
+	std::lock_guard<std::mutex> lock(parseMutex);
+	std::map<unsigned long, Object*>::iterator it = preparedObjects.find(address);
+	if(it == preparedObjects.end())
+		return NULL;
+	Object* object = it->second;
+	preparedObjects.erase(it);
+	return object;
 }
 
 void* File::parseFileBlock(unsigned long adress) {
 	return parseFileBlock(getBlockByAddress(adress));
 }
 
-unsigned int File::getNumberOfTypes(string typeName) {
-	unsigned int count = 0;
+void File::buildTypeIndex() {
+	blocksByType.clear();
+	blocksByType.resize(catalog.structures.size());
+	blocksByName.clear();
+
+	//ID blocks start with an ID structure that holds the name
+	int idIndex = catalog.getStructureIndex("ID");
+	idNameOffset = -1;
+	if(idIndex != -1 && catalog.structures[idIndex].hasField("name"))
+		idNameOffset = catalog.structures[idIndex].getField("name").offset;
+
 	for(Block& block: blocks) {
-		if(block.structure->type->name == typeName)
-			count++;
+		if(block.SDNAIndex >= blocksByType.size())
+			continue;
+		blocksByType[block.SDNAIndex].push_back(&block);
+
+		if(idNameOffset != -1 && block.code.size() == 2 && block.structure->fields.size() > 0) {
+			DNAField& first = block.structure->fields[0];
+			if(first.offset == 0 && first.type == catalog.structures[idIndex].type && !first.isPointer)
+				blocksByName[readStringAt(block.offset + idNameOffset)] = &block;
+		}
 	}
-	return count;
 }
 
-std::vector<File::Block*> File::getBlocksByType(string typeName) {
-	std::vector<Block*> ret;
-	for(Block& block: blocks) {
-		if(block.structure->type->name == typeName)
-			ret.push_back(&block);
-	}
-	return ret;
+unsigned int File::getNumberOfTypes(string typeName) {
+	return getBlocksByType(typeName).size();
+}
+
+const std::vector<File::Block*>& File::getBlocksByType(string typeName) {
+	static const std::vector<Block*> empty;
+	int index = catalog.getStructureIndex(typeName);
+	if(index == -1 || (unsigned int)index >= blocksByType.size())
+		return empty;
+	return blocksByType[index];
 }
 
 File::Block* File::getBlocksByType(string typeName, unsigned int pos) {
-	unsigned int maxNum = getNumberOfTypes(typeName);
-	if(maxNum <= pos) {
+	const std::vector<Block*>& typeBlocks = getBlocksByType(typeName);
+	if(typeBlocks.size() <= pos) {
 		ofLogWarning(OFX_BLENDER) << typeName << " " << pos << " not found";
 		return NULL;
 	}
-	return getBlocksByType(typeName)[pos];
+	return typeBlocks[pos];
+}
+
+File::Block* File::getBlockByName(string code, string name) {
+	std::unordered_map<std::string, Block*>::iterator it = blocksByName.find(code + name);
+	if(it == blocksByName.end())
+		return NULL;
+	return it->second;
+}
+
+void File::buildAddressIndex() {
+	addressIndex.clear();
+	blocksByAddress.clear();
+	addressIndex.reserve(blocks.size());
+	blocksByAddress.reserve(blocks.size());
+	for(Block& block: blocks) {
+		if(block.address == 0)
+			continue;
+		addressIndex[block.address] = &block;
+		blocksByAddress.push_back(&block);
+	}
+	std::sort(blocksByAddress.begin(), blocksByAddress.end(), [](const Block* b1, const Block* b2) {
+		return b1->address < b2->address;
+	});
 }
 
 bool File::doesAddressExist(unsigned long address) {
-	for(File::Block& block:blocks) {
-		if(block.address == address) {
-			return true;
+	unsigned int offset;
+	return address != 0 && getBlockByAddress(address, offset) != NULL;
+}
+
+string File::getReachableRoots() {
+	if(!filter.reachableOnly)
+		return "";
+	return "SC" + filter.sceneName;
+}
+
+//follows the pointers of the scenes through the DNA and drops every block that is never reached. this runs once all
+//headers are scanned, as the DNA is at the end of the file, so it saves memory and index cache size but no reading
+void File::removeUnreachableBlocks() {
+	std::vector<Block*> roots;
+	if(filter.sceneName.empty()) {
+		roots = getBlocksByType(BL_SCENE);
+	} else if(Block* scene = getBlockByName("SC", filter.sceneName)) {
+		roots.push_back(scene);
+	}
+	if(roots.empty() || blocksByAddress.empty()) {
+		ofLogWarning(OFX_BLENDER) << "Could not find scene \"" << filter.sceneName << "\", keeping all blocks";
+		return;
+	}
+
+	unsigned long minAddress = blocksByAddress.front()->address;
+	unsigned long maxAddress = blocksByAddress.back()->address + blocksByAddress.back()->size;
+	std::vector<char> reachable(blocks.size(), 0);
+	std::vector<Block*> pending;
+	auto visit = [&](unsigned long address) {
+		if(address < minAddress || address >= maxAddress)
+			return;
+		unsigned int offsetInBlock;
+		Block* block = getBlockByAddress(address, offsetInBlock);
+		if(block && !reachable[block - &blocks[0]]) {
+			reachable[block - &blocks[0]] = 1;
+			pending.push_back(block);
 		}
+	};
+	for(Block* root: roots) {
+		reachable[root - &blocks[0]] = 1;
+		pending.push_back(root);
 	}
-	return false;
+
+	std::vector<std::vector<unsigned int> > pointerOffsets(catalog.structures.size());
+	std::vector<char> hasOffsets(catalog.structures.size(), 0);
+	while(!pending.empty()) {
+		Block* block = pending.back();
+		pending.pop_back();
+
+		//raw data like arrays of pointers is written as a DATA block with the index of the first structure, its size
+		//doesn't fit that structure. every pointer sized value in it that hits a block is followed
+		bool isRawData = block->code == "DATA" && block->SDNAIndex == 0 && block->size != block->count * block->structure->type->size;
+		if(isRawData) {
+			for(unsigned int offset=0; offset + pointerSize <= block->size; offset += pointerSize)
+				visit(readPointerAt(block->offset + streamoff(offset)));
+			continue;
+		}
+
+		if(!hasOffsets[block->SDNAIndex]) {
+			collectPointerOffsets(block->SDNAIndex, 0, pointerOffsets[block->SDNAIndex]);
+			hasOffsets[block->SDNAIndex] = 1;
+		}
+		unsigned int structSize = block->structure->type->size;
+		for(unsigned int i=0; i<block->count; i++) {
+			for(unsigned int offset: pointerOffsets[block->SDNAIndex]) {
+				unsigned int inBlock = i * structSize + offset;
+				if(inBlock + pointerSize <= block->size)
+					visit(readPointerAt(block->offset + streamoff(inBlock)));
+			}
+		}
+	}
+
+	std::vector<Block> kept;
+	for(unsigned int i=0; i<blocks.size(); i++) {
+		if(reachable[i] || blocks[i].code == "DNA1" || blocks[i].code == "ENDB")
+			kept.push_back(blocks[i]);
+	}
+	ofLogVerbose(OFX_BLENDER) << "Keeping " << kept.size() << " of " << blocks.size() << " blocks reachable from " << roots.size() << " scene(s)";
+	blocks.swap(kept);
+	buildAddressIndex();
+	buildTypeIndex();
 }
 
-File::Block* File::getBlockByAddress(unsigned long address) {
-	for(File::Block& block:blocks) {
-		if(block.address == address) {
-			return &block;
+//offsets of all pointers in a structure including the ones in nested structures
+void File::collectPointerOffsets(unsigned int structureIndex, unsigned int baseOffset, std::vector<unsigned int>& offsets) {
+	DNAStructure& structure = catalog.structures[structureIndex];
+	for(DNAField& field: structure.fields) {
+		//every datablock is chained to the others of its type, that doesn't make them used
+		if(structure.type->name == "ID" && (field.name->nameClean == "next" || field.name->nameClean == "prev"))
+			continue;
+
+		unsigned int count = 1;
+		for(unsigned int size: field.arraySizes)
+			count *= std::max(size, 1u);
+
+		if(field.isPointer) {
+			for(unsigned int i=0; i<count; i++)
+				offsets.push_back(baseOffset + field.offset + i * pointerSize);
+		} else if(field.structureIndex != -1) {
+			for(unsigned int i=0; i<count; i++)
+				collectPointerOffsets(field.structureIndex, baseOffset + field.offset + i * field.type->size, offsets);
 		}
 	}
-	ofLogWarning(OFX_BLENDER) << "Could not find block at address " << address;
+}
+
+File::Block* File::getBlockByAddress(unsigned long address) {
+	unsigned int offset;
+	Block* block = getBlockByAddress(address, offset);
+	if(block == NULL)
+		ofLogWarning(OFX_BLENDER) << "Could not find block at address " << address;
+	return block;
+}
+
+//blender also stores pointers to elements within a block, those resolve to the block plus an offset
+File::Block* File::getBlockByAddress(unsigned long address, unsigned int& offsetInBlock) {
+	profiler.countAddressLookup();
+	offsetInBlock = 0;
+	std::unordered_map<unsigned long, Block*>::iterator it = addressIndex.find(address);
+	if(it != addressIndex.end())
+		return it->second;
+
+	//find the last block starting before the address
+	std::vector<Block*>::iterator next = std::upper_bound(blocksByAddress.begin(), blocksByAddress.end(), address, [](unsigned long addr, const Block* b) {
+		return addr < b->address;
+	});
+	if(next == blocksByAddress.begin())
+		return NULL;
+	Block* block = *(next - 1);
+	if(address - block->address < block->size) {
+		offsetInBlock = address - block->address;
+		return block;
+	}
 	return NULL;
 }
 
+float File::getDecompressionTime() {
+	return decompressionTime;
+}
+
+float File::getParseTime() {
+	return parseTime;
+}
+
+const LoadProgress& File::getProgress() {
+	return progress;
+}
+
+LoadProfile File::getProfile() {
+	return profiler.getProfile();
+}
+
+MemoryReport File::getMemoryReport() {
+	MemoryReport report;
+	report.add(MemoryReport::FILE_DATA, buffer.isMapped() ? "mapped file" : "file in memory", buffer.size());
+
+	//DNA catalog
+	size_t names = MemoryReport::getBytes(catalog.names);
+	for(DNAName& name: catalog.names)
+		names += MemoryReport::getBytes(name.name) - sizeof(string) + MemoryReport::getBytes(name.nameClean) - sizeof(string);
+	report.add(MemoryReport::DNA_CATALOG, "names", names);
+	size_t types = MemoryReport::getBytes(catalog.types);
+	for(DNAType& type: catalog.types)
+		types += MemoryReport::getBytes(type.name) - sizeof(string);
+	report.add(MemoryReport::DNA_CATALOG, "types", types);
+	size_t structures = MemoryReport::getBytes(catalog.structures);
+	for(DNAStructure& structure: catalog.structures) {
+		structures += MemoryReport::getBytes(structure.fields) + structure.fieldIndices.size() * (sizeof(std::pair<string, unsigned int>) + 2 * sizeof(void*));
+		for(DNAField& field: structure.fields)
+			structures += MemoryReport::getBytes(field.arraySizes);
+	}
+	report.add(MemoryReport::DNA_CATALOG, "structures", structures);
+
+	//block index, hashed entries are counted with a node of two pointers
+	report.add(MemoryReport::BLOCK_INDEX, "blocks", MemoryReport::getBytes(blocks));
+	report.add(MemoryReport::BLOCK_INDEX, "by address", addressIndex.size() * (sizeof(std::pair<unsigned long, Block*>) + 2 * sizeof(void*)) + MemoryReport::getBytes(blocksByAddress));
+	size_t byType = MemoryReport::getBytes(blocksByType);
+	for(std::vector<Block*>& typeBlocks: blocksByType)
+		byType += MemoryReport::getBytes(typeBlocks);
+	report.add(MemoryReport::BLOCK_INDEX, "by type", byType);
+	size_t byName = 0;
+	for(std::pair<const std::string, Block*>& entry: blocksByName)
+		byName += MemoryReport::getBytes(entry.first) + sizeof(Block*) + 2 * sizeof(void*);
+	report.add(MemoryReport::BLOCK_INDEX, "by name", byName);
+
+	//scenes parsed so far
+	for(Block* block: getBlocksByType(BL_SCENE)) {
+		Scene* scene = NULL;
+		{
+			std::lock_guard<std::mutex> lock(parseMutex);
+			std::map<unsigned long, void*>::iterator it = parsedBlocks.find(block->address);
+			if(it != parsedBlocks.end())
+				scene = static_cast<Scene*>(it->second);
+		}
+		if(scene)
+			report.merge(scene->getMemoryReport());
+	}
+	return report;
+}
+
+std::shared_ptr<LoadHandle> File::loadAsync(string path, string sceneName) {
+	if(sceneName.empty())
+		sceneName = filter.sceneName;
+	std::shared_ptr<LoadHandle> previous = loadHandle.lock();
+	if(previous)
+		previous->detach();
+	//the previous scene is released here, its textures and buffers have to be deleted on the GL thread
+	unload();
+	std::shared_ptr<LoadHandle> handle(new LoadHandle(this, path, sceneName));
+	loadHandle = handle;
+	return handle;
+}
+
 ////////
 unsigned int File::getNumberOfScenes() {
 	return getNumberOfTypes(BL_SCENE);
 }
 
+Scene* File::getScene() {
+	if(filter.sceneName.empty())
+		return getScene(0);
+	return getScene(filter.sceneName);
+}
+
 Scene* File::getScene(unsigned int index) {
-	return static_cast<Scene*>(parseFileBlock(getBlocksByType(BL_SCENE, index)));
+	return parseScene(getBlocksByType(BL_SCENE, index));
 }
 
 Scene* File::getScene(string sceneName) {
-	std::vector<File::Block*> sceneBlocks = getBlocksByType(BL_SCENE);
-	for(File::Block* block:sceneBlocks) {
-		Scene* scn = static_cast<Scene*>(parseFileBlock(block));
-		if(scn->name == sceneName)
-			return scn;
-	}
-	return NULL;
+	Block* block = getBlockByName("SC", sceneName);
+	if(block == NULL)
+		return NULL;
+	return parseScene(block);
+}
+
+std::vector<string> File::getSceneNames() {
+	std::vector<string> names;
+	for(Block* block: getBlocksByType(BL_SCENE))
+		names.push_back(readIdName(block));
+	return names;
+}
+
+std::vector<string> File::getObjectNames() {
+	std::vector<string> names;
+	for(Block* block: getBlocksByType(BL_OBJECT))
+		names.push_back(readIdName(block));
+	return names;
 }
 
 unsigned int File::getNumberOfObjects() {
@@ -349,6 +1510,13 @@ Object* File::getObject(unsigned int index) {
 	return static_cast<Object*>(parseFileBlock(getBlocksByType(BL_OBJECT, index)));
 }
 
+Object* File::getObject(string objectName) {
+	Block* block = getBlockByName("OB", objectName);
+	if(block == NULL)
+		return NULL;
+	return static_cast<Object*>(parseFileBlock(block));
+}
+
 Object* File::getObjectByAddress(unsigned long address) {
 	return static_cast<Object*>(parseFileBlock(getBlockByAddress(address)));
 }
@@ -483,5 +1651,192 @@ void File::exportStructure(string path) {
 	fb.close();
 }
 
+bool File::isLittleEndian() {
+	bool swapped = layout == LAYOUT_32_SWAPPED || layout == LAYOUT_64_SWAPPED;
+	return isHostLittleEndian() != swapped;
+}
+
+//the generated layouts are only used if pointer size, byte order and all fields of a structure match the file
+void File::validateLayouts() {
+	layoutStructures.assign(layout::numLayouts, -1);
+	if(pointerSize != layout::pointerSize || isLittleEndian() != layout::littleEndian || isLittleEndian() != isHostLittleEndian())
+		return;
+
+	for(unsigned int i=0; i<layout::numLayouts; i++) {
+		const LayoutStruct& generated = layout::getLayout(i);
+		int index = catalog.getStructureIndex(generated.name);
+		if(index == -1)
+			continue;
+
+		DNAStructure& structure = catalog.structures[index];
+		bool matches = structure.type->size == generated.size && structure.fields.size() == generated.numFields;
+		for(unsigned int j=0; matches && j<generated.numFields; j++) {
+			DNAField& field = structure.fields[j];
+			matches = field.offset == generated.fields[j].offset && field.name->name == generated.fields[j].name && field.type->name == generated.fields[j].type;
+		}
+
+		if(matches)
+			layoutStructures[i] = index;
+		else
+			ofLogVerbose(OFX_BLENDER) << "Layout of " << generated.name << " differs from the generated one, using the generic reader";
+	}
+}
+
+//c++ type of a DNA type, empty if it is not a plain value of the same size
+static string getLayoutValueType(DNAType* type) {
+	static std::map<string, std::pair<string, unsigned int> > valueTypes = {
+		{"char", {"char", 1}}, {"uchar", {"unsigned char", 1}},
+		{"short", {"short", 2}}, {"ushort", {"unsigned short", 2}},
+		{"int", {"int", 4}}, {"long", {"int32_t", 4}}, {"ulong", {"uint32_t", 4}},
+		{"float", {"float", 4}}, {"double", {"double", 8}},
+		{"int64_t", {"int64_t", 8}}, {"uint64_t", {"uint64_t", 8}}
+	};
+	std::map<string, std::pair<string, unsigned int> >::iterator it = valueTypes.find(type->name);
+	if(it == valueTypes.end() || it->second.second != type->size)
+		return "";
+	return it->second.first;
+}
+
+//field names that can't be used as accessors
+static bool isLayoutIdentifier(const string& name) {
+	static std::set<string> reserved = {
+		"structSize", "layoutIndex", "offsets", "getLayout", "isValid", "getBytes", "get", "at", "bytes",
+		"auto", "bool", "break", "case", "catch", "class", "const", "continue", "default", "delete", "do", "else", "enum",
+		"explicit", "extern", "false", "for", "friend", "goto", "if", "inline", "mutable", "namespace", "new",
+		"operator", "private", "protected", "public", "register", "return", "signed", "sizeof", "static", "struct",
+		"switch", "template", "this", "throw", "true", "try", "typedef", "union", "unsigned", "using", "virtual",
+		"void", "volatile", "while"
+	};
+	if(name.empty() || isdigit(name[0]) || reserved.count(name))
+		return false;
+	for(char c: name) {
+		if(!isalnum(c) && c != '_')
+			return false;
+	}
+	return true;
+}
+
+void File::exportLayout(string path, std::vector<string> structureNames) {
+	std::ofstream out(ofToDataPath(path, true).c_str());
+	if(!out.is_open()) {
+		ofLogWarning(OFX_BLENDER) << "Could not write layout to " << path;
+		return;
+	}
+
+	string pointerType = pointerSize == 8 ? "uint64_t" : "uint32_t";
+
+	out << "#ifndef BLENDER_GENERATEDLAYOUT_H" << endl;
+	out << "#define BLENDER_GENERATEDLAYOUT_H" << endl << endl;
+	out << "//generated with File::exportLayout from a version " << version << " blend file with " << pointerSize << " byte pointers, do not edit" << endl << endl;
+	out << "#include \"Layout.h\"" << endl << endl;
+	out << "namespace ofx {" << endl << "namespace blender {" << endl << "namespace layout {" << endl << endl;
+	out << "const unsigned int pointerSize = " << pointerSize << ";" << endl;
+	out << "const bool littleEndian = " << (isLittleEndian() ? "true" : "false") << ";" << endl << endl;
+
+	std::vector<string> exported;
+	for(string& structureName: structureNames) {
+		DNAStructure* structure = catalog.getStructure(structureName);
+		if(!structure)
+			continue;
+
+		out << "class " << structureName << ": public StructView {" << endl;
+		out << "public:" << endl;
+		out << "\tstatic constexpr unsigned int layoutIndex = " << exported.size() << ";" << endl;
+		out << "\tstatic constexpr unsigned int structSize = " << structure->type->size << ";" << endl << endl;
+
+		//offsets of all fields that can be named
+		std::set<string> names;
+		std::vector<DNAField*> namedFields;
+		for(DNAField& field: structure->fields) {
+			if(isLayoutIdentifier(field.name->nameClean) && names.insert(field.name->nameClean).second)
+				namedFields.push_back(&field);
+		}
+		out << "\tstruct offsets {" << endl;
+		for(DNAField* field: namedFields) {
+			out << "\t\tstatic constexpr unsigned int " << field->name->nameClean << " = " << field->offset << ";" << endl;
+		}
+		out << "\t};" << endl << endl;
+
+		out << "\t" << structureName << "(const char* bytes=NULL): StructView(bytes) {}" << endl << endl;
+		out << "\t" << structureName << " operator[](unsigned int index) const {" << endl;
+		out << "\t\treturn " << structureName << "(bytes + index * structSize);" << endl;
+		out << "\t}" << endl << endl;
+
+		//accessors
+		for(DNAField* field: namedFields) {
+			const string& name = field->name->nameClean;
+			string offset = "offsets::" + name;
+			bool isPointer = field->isPointer || field->name->name[0] == '(';
+			string valueType = getLayoutValueType(field->type);
+			unsigned int cols = field->arrayDimensions > 1 ? field->arraySizes[1] : 1;
+
+			out << "\t//" << field->type->name << " " << field->name->name << endl;
+			if(isPointer) {
+				if(field->isArray && field->arrayDimensions > 0) {
+					out << "\tunsigned long " << name << "(unsigned int i) const {" << endl;
+					out << "\t\treturn get<" << pointerType << ">(" << offset << " + i * " << pointerSize << ");" << endl;
+				} else {
+					out << "\tunsigned long " << name << "() const {" << endl;
+					out << "\t\treturn get<" << pointerType << ">(" << offset << ");" << endl;
+				}
+			} else if(valueType == "char" && field->arrayDimensions == 1) {
+				out << "\tconst char* " << name << "() const {" << endl;
+				out << "\t\treturn at(" << offset << ");" << endl;
+			} else if(!valueType.empty()) {
+				if(field->arrayDimensions == 2) {
+					out << "\t" << valueType << " " << name << "(unsigned int i, unsigned int j) const {" << endl;
+					out << "\t\treturn get<" << valueType << ">(" << offset << " + (i * " << cols << " + j) * " << field->type->size << ");" << endl;
+				} else if(field->arrayDimensions == 1) {
+					out << "\t" << valueType << " " << name << "(unsigned int i) const {" << endl;
+					out << "\t\treturn get<" << valueType << ">(" << offset << " + i * " << field->type->size << ");" << endl;
+				} else {
+					out << "\t" << valueType << " " << name << "() const {" << endl;
+					out << "\t\treturn get<" << valueType << ">(" << offset << ");" << endl;
+				}
+			} else {
+				//nested structures and unknown types are handed out as raw bytes
+				if(field->arrayDimensions > 0) {
+					out << "\tconst char* " << name << "(unsigned int i) const {" << endl;
+					out << "\t\treturn at(" << offset << " + i * " << field->type->size << ");" << endl;
+				} else {
+					out << "\tconst char* " << name << "() const {" << endl;
+					out << "\t\treturn at(" << offset << ");" << endl;
+				}
+			}
+			out << "\t}" << endl;
+		}
+		out << endl;
+
+		//the full field list, checked against the DNA of every loaded file
+		out << "\tstatic const LayoutStruct& getLayout() {" << endl;
+		out << "\t\tstatic const LayoutField fields[] = {" << endl;
+		for(unsigned int i=0; i<structure->fields.size(); i++) {
+			DNAField& field = structure->fields[i];
+			out << "\t\t\t{\"" << field.name->name << "\", \"" << field.type->name << "\", " << field.offset << "}";
+			out << (i + 1 < structure->fields.size() ? "," : "") << endl;
+		}
+		out << "\t\t};" << endl;
+		out << "\t\tstatic const LayoutStruct layout = {\"" << structureName << "\", structSize, fields, " << structure->fields.size() << "};" << endl;
+		out << "\t\treturn layout;" << endl;
+		out << "\t}" << endl;
+		out << "};" << endl << endl;
+
+		exported.push_back(structureName);
+	}
+
+	out << "const unsigned int numLayouts = " << exported.size() << ";" << endl << endl;
+	out << "inline const LayoutStruct& getLayout(unsigned int index) {" << endl;
+	out << "\tstatic const LayoutStruct* layouts[] = {" << endl;
+	for(unsigned int i=0; i<exported.size(); i++) {
+		out << "\t\t&" << exported[i] << "::getLayout()" << (i + 1 < exported.size() ? "," : "") << endl;
+	}
+	out << "\t};" << endl;
+	out << "\treturn *layouts[index];" << endl;
+	out << "}" << endl << endl;
+
+	out << "}" << endl << "}" << endl << "}" << endl << endl;
+	out << "#endif // BLENDER_GENERATEDLAYOUT_H" << endl;
+}
+
 }
 }
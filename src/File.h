@@ -3,9 +3,22 @@
 
 
 #include "Utils.h"
+#include "FileBuffer.h"
+#include "ByteOrder.h"
+#include "ArrayView.h"
 #include "Scene.h"
 #include <functional>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
 #include "Object.h"
+#include "LoadFilter.h"
+#include "Arena.h"
+#include "MemoryReport.h"
+#include "Profiler.h"
 
 namespace ofx
 {
@@ -56,6 +69,7 @@ public:
 		name=n;
 		type=t;
 		offset=off;
+		structureIndex = -1;
 
 		isPointer = false;
 		isArray = false;
@@ -99,6 +113,8 @@ public:
 	DNAName* name;
 	DNAType* type;
 	unsigned int offset;
+	//SDNA index of the field type if it is a structure, -1 otherwise
+	int structureIndex;
 
 	bool isPointer;
 	bool isArray;
@@ -113,24 +129,70 @@ public:
 		type = t;
 	}
 
-	bool hasField(string fieldName) {
-		for(DNAField& field: fields) {
-			if(field.name->nameClean == fieldName)
-				return true;
+	void buildIndex() {
+		fieldIndices.clear();
+		for(unsigned int i=0; i<fields.size(); i++) {
+			//the first field wins if a name appears twice
+			fieldIndices.insert(std::make_pair(fields[i].name->nameClean, i));
 		}
-		return false;
+	}
+
+	//returns -1 if the structure has no such field
+	int getFieldIndex(const std::string& fieldName) {
+		std::unordered_map<std::string, unsigned int>::iterator it = fieldIndices.find(fieldName);
+		if(it == fieldIndices.end())
+			return -1;
+		return it->second;
+	}
+
+	bool hasField(string fieldName) {
+		return getFieldIndex(fieldName) != -1;
 	}
 
 	DNAField& getField(string fieldName) {
-		for(DNAField& field: fields) {
-			if(field.name->nameClean == fieldName)
-				return field;
-		}
-		return fields[0];
+		int index = getFieldIndex(fieldName);
+		if(index == -1)
+			return fields[0];
+		return fields[index];
 	}
 
 	DNAType* type;
 	std::vector<DNAField> fields;
+	std::unordered_map<std::string, unsigned int> fieldIndices;
+};
+
+//a field looked up by name. handles constructed with a structure name are registered and resolved once per file
+//when the catalog is built, e.g. static FieldHandle co("MVert", "co"). handles made from a plain field name
+//are looked up in whatever structure they are used with
+class FieldHandle
+{
+public:
+	FieldHandle(std::string structureName, std::string fieldName);
+	FieldHandle(const char* fieldName): fieldName(fieldName), slot(-1) {}
+	FieldHandle(const std::string& fieldName): fieldName(fieldName), slot(-1) {}
+
+	std::string structureName;
+	std::string fieldName;
+	int slot;
+
+	//structure and field names of all registered handles, the position is the slot
+	static std::vector<std::pair<std::string, std::string> >& getRegistry();
+};
+
+inline std::ostream& operator<<(std::ostream& os, const FieldHandle& handle) {
+	return os << handle.fieldName;
+}
+
+//a structure type registered once and resolved to its SDNA index per file, e.g. static StructHandle mloopuv("MLoopUV")
+class StructHandle
+{
+public:
+	explicit StructHandle(std::string structureName);
+
+	std::string structureName;
+	int slot;
+
+	static std::vector<std::string>& getRegistry();
 };
 
 class DNACatalog
@@ -139,20 +201,66 @@ public:
 	vector<DNAName> names;
 	vector<DNAType> types;
 	vector<DNAStructure> structures;
+	//structure name to SDNA index
+	std::unordered_map<std::string, unsigned int> structureIndices;
+
+	//field and structure handles resolved for this catalog, indexed by their slot
+	std::vector<DNAStructure*> handleStructures;
+	std::vector<DNAField*> handleFields;
+	std::vector<int> handleStructureIndices;
+
+	void buildIndex() {
+		structureIndices.clear();
+		for(unsigned int i=0; i<structures.size(); i++) {
+			structureIndices[structures[i].type->name] = i;
+			structures[i].buildIndex();
+		}
 
-	bool hasStructure(std::string name) {
-		for(vector<DNAStructure>::iterator it = structures.begin(); it<structures.end(); it++) {
-			if((*it).type->name == name)
-				return true;
+		//nested structures
+		for(DNAStructure& structure: structures) {
+			for(DNAField& field: structure.fields) {
+				field.structureIndex = getStructureIndex(field.type->name);
+			}
 		}
-		return false;
+
+		resolveHandles();
+	}
+
+	void resolveHandles();
+
+	//the resolved field if the handle was registered for this structure, otherwise a lookup by name
+	DNAField* getField(const FieldHandle& handle, DNAStructure* structure) {
+		if(handle.slot >= 0 && (unsigned int)handle.slot < handleFields.size() && handleStructures[handle.slot] == structure)
+			return handleFields[handle.slot];
+		int index = structure->getFieldIndex(handle.fieldName);
+		if(index == -1)
+			return NULL;
+		return &structure->fields[index];
+	}
+
+	//returns -1 if the structure is not in the catalog
+	int getStructureIndex(const StructHandle& handle) {
+		if(handle.slot >= 0 && (unsigned int)handle.slot < handleStructureIndices.size())
+			return handleStructureIndices[handle.slot];
+		return getStructureIndex(handle.structureName);
+	}
+
+	//returns -1 if the structure is not in the catalog
+	int getStructureIndex(std::string name) {
+		std::unordered_map<std::string, unsigned int>::iterator it = structureIndices.find(name);
+		if(it == structureIndices.end())
+			return -1;
+		return it->second;
+	}
+
+	bool hasStructure(std::string name) {
+		return getStructureIndex(name) != -1;
 	}
 
 	DNAStructure* getStructure(std::string name) {
-		for(vector<DNAStructure>::iterator it = structures.begin(); it<structures.end(); it++) {
-			if((*it).type->name == name)
-				return &(*it);
-		}
+		int index = getStructureIndex(name);
+		if(index != -1)
+			return &structures[index];
 		ofLogWarning(OFX_BLENDER) << "Structure " << name << " not found in DNA Catalog";
 		return NULL;
 	}
@@ -160,6 +268,25 @@ public:
 
 ////////////////////////////////////////////////////////////////////////////////////////// FILE
 class DNAStructureReader;
+class LoadHandle;
+
+//progress of the current load, updated while loading and safe to read from any thread
+struct LoadProgress
+{
+	std::atomic<unsigned long long> bytesRead;
+	std::atomic<unsigned long long> bytesTotal;
+	std::atomic<unsigned int> blocksParsed;
+	std::atomic<unsigned int> meshesBuilt;
+	std::atomic<unsigned int> meshesTotal;
+
+	void reset() {
+		bytesRead = 0;
+		bytesTotal = 0;
+		blocksParsed = 0;
+		meshesBuilt = 0;
+		meshesTotal = 0;
+	}
+};
 
 class File
 {
@@ -169,14 +296,58 @@ public:
 	~File();
 
 	bool load(string path);
+	//releases everything parsed from the file, scenes and objects handed out before are deleted unless the arena is still held
+	void unload();
+	//owner of all parsed scenes, objects, animations..., holding on to it keeps them alive after unload or a reload
+	std::shared_ptr<Arena> getArena();
+	//loads the file and parses a scene (the first one if sceneName is empty) on background threads,
+	//the file must not be used until the handle has finished, see LoadHandle. destroying the file or starting
+	//another load waits for the background thread and the handle fails
+	std::shared_ptr<LoadHandle> loadAsync(string path, string sceneName="");
 	void exportStructure(string path="structure.html");
+	//writes a header with the offsets and typed accessors of the given structures, see GeneratedLayout.h
+	void exportLayout(string path="GeneratedLayout.h", std::vector<string> structureNames={"Object", "BezTriple", "FCurve"});
 	unsigned int getNumberOfScenes();
+	//the scene named in filter, or the first one
+	Scene* getScene();
 	Scene* getScene(unsigned int index);
 	Scene* getScene(string sceneName);
+	//names read from the block headers without parsing anything
+	std::vector<string> getSceneNames();
+	std::vector<string> getObjectNames();
 	unsigned int getNumberOfObjects();
 	Object* getObject(unsigned int index);
+	Object* getObject(string objectName);
+
+	//duration of the last load in milliseconds, split into decompression and parsing of the file structure
+	float getDecompressionTime();
+	float getParseTime();
+	const LoadProgress& getProgress();
+	//memory used by the file itself and by all scenes parsed from it
+	MemoryReport getMemoryReport();
+	//phase timings and I/O counters of the last load and everything parsed since, empty unless profiling is set
+	LoadProfile getProfile();
+	//builds the meshes parsed with a scene on numThreads threads, getScene does this before returning. only the cpu
+	//side of Mesh::build runs here, the vbos are created on the GL thread when the meshes are uploaded or drawn
+	void buildAll();
 	
-	bool skipTextures;
+	//what getScene and loadAsync parse, everything by default
+	LoadFilter filter;
+	//inflate compressed files into memory instead of a temporary file
+	bool inflateInMemory;
+	//store the block headers and DNA catalog in a sidecar file and reuse them when the blend file is unchanged
+	bool useIndexCache;
+	//where the index cache is stored, next to the blend file if empty
+	string indexCacheDirectory;
+	//parse meshes, materials and textures of a scene on worker threads before the scene itself, needs the file in memory
+	bool parallelParsing;
+	//number of worker threads for parallel parsing, 0 uses all cores
+	unsigned int numThreads;
+	//record timings and counters from the next load on, see getProfile
+	bool profiling;
+	//upload textures and meshes while parsing, turn off to parse without a GL context (tools, benchmarks),
+	//textures are then only loaded into pixels and meshes only drawn through their primitives
+	bool uploadToGpu;
 	
 private:
 	class Block
@@ -195,46 +366,247 @@ private:
 		DNAStructure* structure;
 	};
 
+	struct IndexCacheKey {
+		unsigned long long fileSize;
+		long long modified;
+		unsigned long long hash;
+	};
+
+	//decodes count values in the byte order of the file, the layout is fixed when the header is read
+	template<typename Type>
+	void decode(const char* data, Type* values, size_t count) {
+		switch(layout) {
+		case LAYOUT_32_NATIVE: Decoder<4, false>::values(data, values, count); break;
+		case LAYOUT_64_NATIVE: Decoder<8, false>::values(data, values, count); break;
+		case LAYOUT_32_SWAPPED: Decoder<4, true>::values(data, values, count); break;
+		case LAYOUT_64_SWAPPED: Decoder<8, true>::values(data, values, count); break;
+		}
+	}
+
+	unsigned long decodePointer(const char* data) {
+		switch(layout) {
+		case LAYOUT_32_NATIVE: return Decoder<4, false>::pointer(data);
+		case LAYOUT_64_NATIVE: return Decoder<8, false>::pointer(data);
+		case LAYOUT_32_SWAPPED: return Decoder<4, true>::pointer(data);
+		case LAYOUT_64_SWAPPED: return Decoder<8, true>::pointer(data);
+		}
+		return 0;
+	}
+
+	//reads numBytes raw bytes at the read position, from the mapped bytes if available, otherwise from the stream
+	const char* readRaw(char* temp, size_t numBytes) {
+		profiler.countBytes(numBytes);
+		if(buffer.isOpen()) {
+			const char* data = buffer.at(cursor, numBytes);
+			cursor += numBytes;
+			return data;
+		}
+		if(!file.read(temp, numBytes))
+			return NULL;
+		return temp;
+	}
+
+	//reads numBytes raw bytes at an absolute position, does not touch the read position when the file is mapped
+	const char* readRawAt(streamoff offset, char* temp, size_t numBytes) {
+		if(buffer.isOpen()) {
+			profiler.countBytes(numBytes);
+			return buffer.at(offset, numBytes);
+		}
+		seek(offset);
+		return readRaw(temp, numBytes);
+	}
+
 	//templated read function
 	template<typename Type>
 	Type read() {
-		Type ret;
-		file.read((char*)&ret, sizeof(Type));
+		Type ret = Type();
+		char temp[sizeof(Type)];
+		const char* data = readRaw(temp, sizeof(Type));
+		if(data)
+			decode<Type>(data, &ret, 1);
 		return ret;
 	}
 
+	unsigned long readPointer() {
+		char temp[8];
+		const char* data = readRaw(temp, pointerSize);
+		if(!data)
+			return 0;
+		return decodePointer(data);
+	}
+
+	//read at an absolute position
+	template<typename Type>
+	Type readAt(streamoff offset) {
+		Type ret = Type();
+		char temp[sizeof(Type)];
+		const char* data = readRawAt(offset, temp, sizeof(Type));
+		if(data)
+			decode<Type>(data, &ret, 1);
+		else
+			ofLogWarning(OFX_BLENDER) << "Read at " << offset << " is outside of the file";
+		return ret;
+	}
+
+	//read count consecutive values at an absolute position
+	template<typename Type>
+	bool readAt(streamoff offset, Type* values, size_t count) {
+		if(count == 0)
+			return true;
+		std::vector<char> temp;
+		if(!buffer.isOpen())
+			temp.resize(sizeof(Type) * count);
+		const char* data = readRawAt(offset, temp.data(), sizeof(Type) * count);
+		if(!data) {
+			ofLogWarning(OFX_BLENDER) << "Read of " << count << " values at " << offset << " is outside of the file";
+			return false;
+		}
+		decode<Type>(data, values, count);
+		return true;
+	}
+
+	unsigned long readPointerAt(streamoff offset) {
+		char temp[8];
+		const char* data = readRawAt(offset, temp, pointerSize);
+		if(!data)
+			return 0;
+		return decodePointer(data);
+	}
+
 	template<typename Type>
 	Type* readMany(unsigned int howMany) {
 		Type* ret = new Type[howMany];
-		for(unsigned int i=0; i<howMany; i++) {
-			ret[i] = read<Type>();
-		}
+		streamoff offset = tell();
+		if(!readAt<Type>(offset, ret, howMany))
+			std::fill(ret, ret + howMany, Type());
+		seek(offset + streamoff(sizeof(Type) * howMany));
 		return ret;
 	}
 
-	char* readChar(streamsize length);
+	//view on count elements of components values each, the elements are stride bytes apart
+	template<typename Type>
+	ArrayView<Type> readView(streamoff offset, size_t count, size_t stride, unsigned int components) {
+		if(count == 0 || components == 0)
+			return ArrayView<Type>();
+		size_t numBytes = (count - 1) * stride + components * sizeof(Type);
+		bool swap = layout == LAYOUT_32_SWAPPED || layout == LAYOUT_64_SWAPPED;
+		profiler.countBytes(numBytes);
+		if(buffer.isOpen()) {
+			const char* data = buffer.at(offset, numBytes);
+			if(!data) {
+				ofLogWarning(OFX_BLENDER) << "View of " << count << " values at " << offset << " is outside of the file";
+				return ArrayView<Type>();
+			}
+			return ArrayView<Type>(data, count, stride, components, swap);
+		}
+
+		//streams can't be viewed, the view owns a copy of the bytes
+		std::shared_ptr<std::vector<char> > bytes(new std::vector<char>(numBytes));
+		seek(offset);
+		if(!file.read(&(*bytes)[0], numBytes)) {
+			file.clear();
+			ofLogWarning(OFX_BLENDER) << "View of " << count << " values at " << offset << " is outside of the file";
+			return ArrayView<Type>();
+		}
+		return ArrayView<Type>(&(*bytes)[0], count, stride, components, swap, bytes);
+	}
+
+	bool inflateGzip(std::vector<char>& out, size_t sizeHint);
+	bool isZstd();
+	bool decompressZstd(const char* data, size_t size, std::vector<char>& out);
 	std::string readString(streamsize length=0);
+	//reads at an absolute position without touching the read position when the file is in memory
+	std::vector<char> readCharAt(streamoff offset, streamsize length);
+	std::string readStringAt(streamoff offset);
+	//trimmed string, the prefix is removed if the string starts with it
+	std::string readNameAt(streamoff offset, const string& prefix="");
+	//name of an ID block (object, mesh, scene...) without the code, e.g. "Cube" for "OBCube"
+	std::string readIdName(Block* block);
 	void readHeader(File::Block& block);
+	void readBlocks();
+	void readCatalog();
+	string getIndexCachePath(string blendPath);
+	IndexCacheKey createIndexCacheKey(string blendPath);
+	bool readIndexCache(string cachePath, IndexCacheKey key, string roots);
+	void writeIndexCache(string cachePath, IndexCacheKey key, string roots);
 	void seek(streamoff to);
+	streamoff tell();
+	bool isEnd();
+	void align();
 	void* parseFileBlock(Block* block);
 	void* parseFileBlock(unsigned long adress);
+	//uploadNow uploads textures and meshes and sets up cameras and lights before returning,
+	//otherwise they stay queued for uploadNext
+	Scene* parseScene(Block* block, bool uploadNow=true);
+	void prepareScene(Block* block, bool uploadNow=true);
+	Object* takePreparedObject(unsigned long address);
+	void deferTexture(Texture* texture);
+	void deferMeshBuild(Mesh* mesh);
+	//the data of the object in block is parsed by uploadNext
+	void deferSetup(Block* block, Object* object);
+	//sets up one queued camera or light or uploads one queued texture or mesh, returns false when nothing is left
+	bool uploadNext();
 
 	unsigned int getNumberOfTypes(string typeName);
-	std::vector<Block*> getBlocksByType(string typeName);
+	const std::vector<Block*>& getBlocksByType(string typeName);
 	Block* getBlocksByType(string typeName, unsigned int pos);
+	Block* getBlockByName(string code, string name);
+	void buildTypeIndex();
 	Block* getBlockByAddress(unsigned long address);
+	Block* getBlockByAddress(unsigned long address, unsigned int& offsetInBlock);
 	Object* getObjectByAddress(unsigned long address);
 	bool doesAddressExist(unsigned long address);
+	void buildAddressIndex();
+	//what the block list was reduced to, empty if all blocks are kept
+	string getReachableRoots();
+	void removeUnreachableBlocks();
+	void collectPointerOffsets(unsigned int structureIndex, unsigned int baseOffset, std::vector<unsigned int>& offsets);
+	bool isLittleEndian();
+	void validateLayouts();
 
-	//function that retreives the pointer type
-	std::function<unsigned long()> readPointer;
 	unsigned int pointerSize;
+	FileLayout layout;
 	string version;
 	std::vector<Block> blocks;
+	//lookup of the old memory addresses, exact matches are hashed, blocksByAddress is sorted for pointers into a block
+	std::unordered_map<unsigned long, Block*> addressIndex;
+	std::vector<Block*> blocksByAddress;
+	//blocks bucketed by their SDNA index and ID blocks by their full name (code + name, e.g. "OBCube")
+	std::vector<std::vector<Block*> > blocksByType;
+	std::unordered_map<std::string, Block*> blocksByName;
+	std::shared_ptr<Arena> arena;
+	//offset of the name inside ID blocks, -1 if the catalog has no ID structure
+	streamoff idNameOffset;
 	std::map<unsigned long, void*> parsedBlocks;
+	//blocks that are being parsed and the thread parsing them
+	std::map<unsigned long, std::thread::id> parsingBlocks;
+	std::mutex parseMutex;
+	std::condition_variable parseDone;
+	//objects with their data parsed ahead on a worker thread, by address of the object block
+	std::map<unsigned long, Object*> preparedObjects;
+	//set while parsing on worker threads, textures are only loaded into pixels and uploaded later
+	bool deferTextureUpload;
+	std::vector<Texture*> deferredTextures;
+	std::vector<Mesh*> deferredMeshes;
+	//set while parsing a scene, meshes are built together by buildAll
+	bool deferMeshBuilds;
+	std::vector<Mesh*> unbuiltMeshes;
+	//set while parsing a scene graph off the GL thread, cameras and lights are created without their data
+	bool deferObjectSetup;
+	std::vector<std::pair<Block*, Object*> > deferredSetups;
+	//the running loadAsync, if any
+	std::weak_ptr<LoadHandle> loadHandle;
+	LoadProgress progress;
+	Profiler profiler;
 	DNACatalog catalog;
+	//SDNA index of every generated layout that matches this file, -1 if it does not
+	std::vector<int> layoutStructures;
+	FileBuffer buffer;
+	size_t cursor;
 	std::ifstream file;
 	float scale;
+	float decompressionTime;
+	float parseTime;
 		
 	//packed files
 	//std::map<string, ofPixels> packedImages;
@@ -245,6 +617,8 @@ private:
 	friend class DNAStructureReader;
 	friend class DNALinkedListReader;
 	friend class Parser;
+	friend class LoadHandle;
+	friend class BlendWriter;
 
 };
 
@@ -0,0 +1,113 @@
+#include "FileBuffer.h"
+
+#ifdef TARGET_WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ofx {
+namespace blender {
+
+FileBuffer::FileBuffer() {
+	data = NULL;
+	length = 0;
+#ifdef TARGET_WIN32
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = NULL;
+#endif
+}
+
+FileBuffer::~FileBuffer() {
+	close();
+}
+
+bool FileBuffer::map(string path) {
+	close();
+
+#ifdef TARGET_WIN32
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER fileSize;
+	if(!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+		close();
+		return false;
+	}
+
+	mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(mappingHandle == NULL) {
+		close();
+		return false;
+	}
+
+	data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if(data == NULL) {
+		close();
+		return false;
+	}
+	length = fileSize.QuadPart;
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd == -1)
+		return false;
+
+	struct stat info;
+	if(fstat(fd, &info) != 0 || info.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	void* mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	//the mapping stays valid after the descriptor is closed
+	::close(fd);
+	if(mapped == MAP_FAILED)
+		return false;
+
+	data = static_cast<const char*>(mapped);
+	length = info.st_size;
+#endif
+
+	return true;
+}
+
+void FileBuffer::assign(std::vector<char>& bytes) {
+	close();
+	if(bytes.empty())
+		return;
+	owned.swap(bytes);
+	data = &owned[0];
+	length = owned.size();
+}
+
+void FileBuffer::close() {
+	if(!owned.empty()) {
+		//release the memory, clear() would keep the capacity
+		std::vector<char>().swap(owned);
+		data = NULL;
+		length = 0;
+	}
+
+#ifdef TARGET_WIN32
+	if(data != NULL)
+		UnmapViewOfFile(data);
+	if(mappingHandle != NULL)
+		CloseHandle(mappingHandle);
+	if(fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle);
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = NULL;
+#else
+	if(data != NULL)
+		munmap(const_cast<char*>(data), length);
+#endif
+	data = NULL;
+	length = 0;
+}
+
+}
+}
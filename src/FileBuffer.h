@@ -0,0 +1,59 @@
+#ifndef FILEBUFFER_H
+#define FILEBUFFER_H
+
+#include "Utils.h"
+
+namespace ofx {
+namespace blender {
+
+//read only view on the raw bytes of a blend file, the bytes are either memory mapped or owned (e.g. inflated files)
+class FileBuffer {
+public:
+	FileBuffer();
+	~FileBuffer();
+
+	bool map(string path);
+	//takes over the contents of bytes
+	void assign(std::vector<char>& bytes);
+	void close();
+
+	bool isMapped() {
+		return data != NULL && owned.empty();
+	}
+
+	bool isOpen() {
+		return data != NULL;
+	}
+
+	const char* getData() {
+		return data;
+	}
+
+	size_t size() {
+		return length;
+	}
+
+	//returns a pointer to numBytes at offset or NULL if the range lies outside the buffer
+	const char* at(size_t offset, size_t numBytes) {
+		if(offset > length || numBytes > length - offset)
+			return NULL;
+		return data + offset;
+	}
+
+private:
+	FileBuffer(const FileBuffer&);
+	FileBuffer& operator=(const FileBuffer&);
+
+	const char* data;
+	size_t length;
+	std::vector<char> owned;
+#ifdef TARGET_WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+};
+
+}
+}
+
+#endif // FILEBUFFER_H
@@ -0,0 +1,1101 @@
+#ifndef BLENDER_GENERATEDLAYOUT_H
+#define BLENDER_GENERATEDLAYOUT_H
+
+//generated with File::exportLayout from a version 271 blend file with 8 byte pointers, do not edit
+
+#include "Layout.h"
+
+namespace ofx {
+namespace blender {
+namespace layout {
+
+const unsigned int pointerSize = 8;
+const bool littleEndian = true;
+
+class Object: public StructView {
+public:
+	static constexpr unsigned int layoutIndex = 0;
+	static constexpr unsigned int structSize = 1424;
+
+	struct offsets {
+		static constexpr unsigned int id = 0;
+		static constexpr unsigned int adt = 120;
+		static constexpr unsigned int sculpt = 128;
+		static constexpr unsigned int type = 136;
+		static constexpr unsigned int partype = 138;
+		static constexpr unsigned int par1 = 140;
+		static constexpr unsigned int par2 = 144;
+		static constexpr unsigned int par3 = 148;
+		static constexpr unsigned int parsubstr = 152;
+		static constexpr unsigned int parent = 216;
+		static constexpr unsigned int track = 224;
+		static constexpr unsigned int proxy = 232;
+		static constexpr unsigned int proxy_group = 240;
+		static constexpr unsigned int proxy_from = 248;
+		static constexpr unsigned int ipo = 256;
+		static constexpr unsigned int bb = 264;
+		static constexpr unsigned int action = 272;
+		static constexpr unsigned int poselib = 280;
+		static constexpr unsigned int pose = 288;
+		static constexpr unsigned int data = 296;
+		static constexpr unsigned int gpd = 304;
+		static constexpr unsigned int avs = 312;
+		static constexpr unsigned int mpath = 360;
+		static constexpr unsigned int constraintChannels = 368;
+		static constexpr unsigned int effect = 384;
+		static constexpr unsigned int defbase = 400;
+		static constexpr unsigned int modifiers = 416;
+		static constexpr unsigned int mode = 432;
+		static constexpr unsigned int restore_mode = 436;
+		static constexpr unsigned int mat = 440;
+		static constexpr unsigned int matbits = 448;
+		static constexpr unsigned int totcol = 456;
+		static constexpr unsigned int actcol = 460;
+		static constexpr unsigned int loc = 464;
+		static constexpr unsigned int dloc = 476;
+		static constexpr unsigned int orig = 488;
+		static constexpr unsigned int size = 500;
+		static constexpr unsigned int dsize = 512;
+		static constexpr unsigned int dscale = 524;
+		static constexpr unsigned int rot = 536;
+		static constexpr unsigned int drot = 548;
+		static constexpr unsigned int quat = 560;
+		static constexpr unsigned int dquat = 576;
+		static constexpr unsigned int rotAxis = 592;
+		static constexpr unsigned int drotAxis = 604;
+		static constexpr unsigned int rotAngle = 616;
+		static constexpr unsigned int drotAngle = 620;
+		static constexpr unsigned int obmat = 624;
+		static constexpr unsigned int parentinv = 688;
+		static constexpr unsigned int constinv = 752;
+		static constexpr unsigned int imat = 816;
+		static constexpr unsigned int imat_ren = 880;
+		static constexpr unsigned int lay = 944;
+		static constexpr unsigned int flag = 948;
+		static constexpr unsigned int colbits = 950;
+		static constexpr unsigned int transflag = 952;
+		static constexpr unsigned int protectflag = 954;
+		static constexpr unsigned int trackflag = 956;
+		static constexpr unsigned int upflag = 958;
+		static constexpr unsigned int nlaflag = 960;
+		static constexpr unsigned int ipoflag = 962;
+		static constexpr unsigned int scaflag = 964;
+		static constexpr unsigned int scavisflag = 966;
+		static constexpr unsigned int depsflag = 967;
+		static constexpr unsigned int dupon = 968;
+		static constexpr unsigned int dupoff = 972;
+		static constexpr unsigned int dupsta = 976;
+		static constexpr unsigned int dupend = 980;
+		static constexpr unsigned int pad = 984;
+		static constexpr unsigned int mass = 988;
+		static constexpr unsigned int damping = 992;
+		static constexpr unsigned int inertia = 996;
+		static constexpr unsigned int formfactor = 1000;
+		static constexpr unsigned int rdamping = 1004;
+		static constexpr unsigned int margin = 1008;
+		static constexpr unsigned int max_vel = 1012;
+		static constexpr unsigned int min_vel = 1016;
+		static constexpr unsigned int obstacleRad = 1020;
+		static constexpr unsigned int step_height = 1024;
+		static constexpr unsigned int jump_speed = 1028;
+		static constexpr unsigned int fall_speed = 1032;
+		static constexpr unsigned int col_group = 1036;
+		static constexpr unsigned int col_mask = 1038;
+		static constexpr unsigned int rotmode = 1040;
+		static constexpr unsigned int boundtype = 1042;
+		static constexpr unsigned int collision_boundtype = 1043;
+		static constexpr unsigned int dtx = 1044;
+		static constexpr unsigned int dt = 1046;
+		static constexpr unsigned int empty_drawtype = 1047;
+		static constexpr unsigned int empty_drawsize = 1048;
+		static constexpr unsigned int dupfacesca = 1052;
+		static constexpr unsigned int prop = 1056;
+		static constexpr unsigned int sensors = 1072;
+		static constexpr unsigned int controllers = 1088;
+		static constexpr unsigned int actuators = 1104;
+		static constexpr unsigned int sf = 1120;
+		static constexpr unsigned int index = 1124;
+		static constexpr unsigned int actdef = 1126;
+		static constexpr unsigned int col = 1128;
+		static constexpr unsigned int gameflag = 1144;
+		static constexpr unsigned int gameflag2 = 1148;
+		static constexpr unsigned int bsoft = 1152;
+		static constexpr unsigned int restrictflag = 1160;
+		static constexpr unsigned int recalc = 1161;
+		static constexpr unsigned int softflag = 1162;
+		static constexpr unsigned int anisotropicFriction = 1164;
+		static constexpr unsigned int constraints = 1176;
+		static constexpr unsigned int nlastrips = 1192;
+		static constexpr unsigned int hooks = 1208;
+		static constexpr unsigned int particlesystem = 1224;
+		static constexpr unsigned int pd = 1240;
+		static constexpr unsigned int soft = 1248;
+		static constexpr unsigned int dup_group = 1256;
+		static constexpr unsigned int body_type = 1264;
+		static constexpr unsigned int shapeflag = 1265;
+		static constexpr unsigned int shapenr = 1266;
+		static constexpr unsigned int smoothresh = 1268;
+		static constexpr unsigned int fluidsimSettings = 1272;
+		static constexpr unsigned int curve_cache = 1280;
+		static constexpr unsigned int derivedDeform = 1288;
+		static constexpr unsigned int derivedFinal = 1296;
+		static constexpr unsigned int lastDataMask = 1304;
+		static constexpr unsigned int customdata_mask = 1312;
+		static constexpr unsigned int state = 1320;
+		static constexpr unsigned int init_state = 1324;
+		static constexpr unsigned int gpulamp = 1328;
+		static constexpr unsigned int pc_ids = 1344;
+		static constexpr unsigned int duplilist = 1360;
+		static constexpr unsigned int rigidbody_object = 1368;
+		static constexpr unsigned int rigidbody_constraint = 1376;
+		static constexpr unsigned int ima_ofs = 1384;
+		static constexpr unsigned int iuser = 1392;
+		static constexpr unsigned int lodlevels = 1400;
+		static constexpr unsigned int currentlod = 1416;
+	};
+
+	Object(const char* bytes=NULL): StructView(bytes) {}
+
+	Object operator[](unsigned int index) const {
+		return Object(bytes + index * structSize);
+	}
+
+	//ID id
+	const char* id() const {
+		return at(offsets::id);
+	}
+	//AnimData *adt
+	unsigned long adt() const {
+		return get<uint64_t>(offsets::adt);
+	}
+	//SculptSession *sculpt
+	unsigned long sculpt() const {
+		return get<uint64_t>(offsets::sculpt);
+	}
+	//short type
+	short type() const {
+		return get<short>(offsets::type);
+	}
+	//short partype
+	short partype() const {
+		return get<short>(offsets::partype);
+	}
+	//int par1
+	int par1() const {
+		return get<int>(offsets::par1);
+	}
+	//int par2
+	int par2() const {
+		return get<int>(offsets::par2);
+	}
+	//int par3
+	int par3() const {
+		return get<int>(offsets::par3);
+	}
+	//char parsubstr[64]
+	const char* parsubstr() const {
+		return at(offsets::parsubstr);
+	}
+	//Object *parent
+	unsigned long parent() const {
+		return get<uint64_t>(offsets::parent);
+	}
+	//Object *track
+	unsigned long track() const {
+		return get<uint64_t>(offsets::track);
+	}
+	//Object *proxy
+	unsigned long proxy() const {
+		return get<uint64_t>(offsets::proxy);
+	}
+	//Object *proxy_group
+	unsigned long proxy_group() const {
+		return get<uint64_t>(offsets::proxy_group);
+	}
+	//Object *proxy_from
+	unsigned long proxy_from() const {
+		return get<uint64_t>(offsets::proxy_from);
+	}
+	//Ipo *ipo
+	unsigned long ipo() const {
+		return get<uint64_t>(offsets::ipo);
+	}
+	//BoundBox *bb
+	unsigned long bb() const {
+		return get<uint64_t>(offsets::bb);
+	}
+	//bAction *action
+	unsigned long action() const {
+		return get<uint64_t>(offsets::action);
+	}
+	//bAction *poselib
+	unsigned long poselib() const {
+		return get<uint64_t>(offsets::poselib);
+	}
+	//bPose *pose
+	unsigned long pose() const {
+		return get<uint64_t>(offsets::pose);
+	}
+	//void *data
+	unsigned long data() const {
+		return get<uint64_t>(offsets::data);
+	}
+	//bGPdata *gpd
+	unsigned long gpd() const {
+		return get<uint64_t>(offsets::gpd);
+	}
+	//bAnimVizSettings avs
+	const char* avs() const {
+		return at(offsets::avs);
+	}
+	//bMotionPath *mpath
+	unsigned long mpath() const {
+		return get<uint64_t>(offsets::mpath);
+	}
+	//ListBase constraintChannels
+	const char* constraintChannels() const {
+		return at(offsets::constraintChannels);
+	}
+	//ListBase effect
+	const char* effect() const {
+		return at(offsets::effect);
+	}
+	//ListBase defbase
+	const char* defbase() const {
+		return at(offsets::defbase);
+	}
+	//ListBase modifiers
+	const char* modifiers() const {
+		return at(offsets::modifiers);
+	}
+	//int mode
+	int mode() const {
+		return get<int>(offsets::mode);
+	}
+	//int restore_mode
+	int restore_mode() const {
+		return get<int>(offsets::restore_mode);
+	}
+	//Material **mat
+	unsigned long mat(unsigned int i) const {
+		return get<uint64_t>(offsets::mat + i * 8);
+	}
+	//char *matbits
+	unsigned long matbits() const {
+		return get<uint64_t>(offsets::matbits);
+	}
+	//int totcol
+	int totcol() const {
+		return get<int>(offsets::totcol);
+	}
+	//int actcol
+	int actcol() const {
+		return get<int>(offsets::actcol);
+	}
+	//float loc[3]
+	float loc(unsigned int i) const {
+		return get<float>(offsets::loc + i * 4);
+	}
+	//float dloc[3]
+	float dloc(unsigned int i) const {
+		return get<float>(offsets::dloc + i * 4);
+	}
+	//float orig[3]
+	float orig(unsigned int i) const {
+		return get<float>(offsets::orig + i * 4);
+	}
+	//float size[3]
+	float size(unsigned int i) const {
+		return get<float>(offsets::size + i * 4);
+	}
+	//float dsize[3]
+	float dsize(unsigned int i) const {
+		return get<float>(offsets::dsize + i * 4);
+	}
+	//float dscale[3]
+	float dscale(unsigned int i) const {
+		return get<float>(offsets::dscale + i * 4);
+	}
+	//float rot[3]
+	float rot(unsigned int i) const {
+		return get<float>(offsets::rot + i * 4);
+	}
+	//float drot[3]
+	float drot(unsigned int i) const {
+		return get<float>(offsets::drot + i * 4);
+	}
+	//float quat[4]
+	float quat(unsigned int i) const {
+		return get<float>(offsets::quat + i * 4);
+	}
+	//float dquat[4]
+	float dquat(unsigned int i) const {
+		return get<float>(offsets::dquat + i * 4);
+	}
+	//float rotAxis[3]
+	float rotAxis(unsigned int i) const {
+		return get<float>(offsets::rotAxis + i * 4);
+	}
+	//float drotAxis[3]
+	float drotAxis(unsigned int i) const {
+		return get<float>(offsets::drotAxis + i * 4);
+	}
+	//float rotAngle
+	float rotAngle() const {
+		return get<float>(offsets::rotAngle);
+	}
+	//float drotAngle
+	float drotAngle() const {
+		return get<float>(offsets::drotAngle);
+	}
+	//float obmat[4][4]
+	float obmat(unsigned int i, unsigned int j) const {
+		return get<float>(offsets::obmat + (i * 4 + j) * 4);
+	}
+	//float parentinv[4][4]
+	float parentinv(unsigned int i, unsigned int j) const {
+		return get<float>(offsets::parentinv + (i * 4 + j) * 4);
+	}
+	//float constinv[4][4]
+	float constinv(unsigned int i, unsigned int j) const {
+		return get<float>(offsets::constinv + (i * 4 + j) * 4);
+	}
+	//float imat[4][4]
+	float imat(unsigned int i, unsigned int j) const {
+		return get<float>(offsets::imat + (i * 4 + j) * 4);
+	}
+	//float imat_ren[4][4]
+	float imat_ren(unsigned int i, unsigned int j) const {
+		return get<float>(offsets::imat_ren + (i * 4 + j) * 4);
+	}
+	//int lay
+	int lay() const {
+		return get<int>(offsets::lay);
+	}
+	//short flag
+	short flag() const {
+		return get<short>(offsets::flag);
+	}
+	//short colbits
+	short colbits() const {
+		return get<short>(offsets::colbits);
+	}
+	//short transflag
+	short transflag() const {
+		return get<short>(offsets::transflag);
+	}
+	//short protectflag
+	short protectflag() const {
+		return get<short>(offsets::protectflag);
+	}
+	//short trackflag
+	short trackflag() const {
+		return get<short>(offsets::trackflag);
+	}
+	//short upflag
+	short upflag() const {
+		return get<short>(offsets::upflag);
+	}
+	//short nlaflag
+	short nlaflag() const {
+		return get<short>(offsets::nlaflag);
+	}
+	//short ipoflag
+	short ipoflag() const {
+		return get<short>(offsets::ipoflag);
+	}
+	//short scaflag
+	short scaflag() const {
+		return get<short>(offsets::scaflag);
+	}
+	//char scavisflag
+	char scavisflag() const {
+		return get<char>(offsets::scavisflag);
+	}
+	//char depsflag
+	char depsflag() const {
+		return get<char>(offsets::depsflag);
+	}
+	//int dupon
+	int dupon() const {
+		return get<int>(offsets::dupon);
+	}
+	//int dupoff
+	int dupoff() const {
+		return get<int>(offsets::dupoff);
+	}
+	//int dupsta
+	int dupsta() const {
+		return get<int>(offsets::dupsta);
+	}
+	//int dupend
+	int dupend() const {
+		return get<int>(offsets::dupend);
+	}
+	//int pad
+	int pad() const {
+		return get<int>(offsets::pad);
+	}
+	//float mass
+	float mass() const {
+		return get<float>(offsets::mass);
+	}
+	//float damping
+	float damping() const {
+		return get<float>(offsets::damping);
+	}
+	//float inertia
+	float inertia() const {
+		return get<float>(offsets::inertia);
+	}
+	//float formfactor
+	float formfactor() const {
+		return get<float>(offsets::formfactor);
+	}
+	//float rdamping
+	float rdamping() const {
+		return get<float>(offsets::rdamping);
+	}
+	//float margin
+	float margin() const {
+		return get<float>(offsets::margin);
+	}
+	//float max_vel
+	float max_vel() const {
+		return get<float>(offsets::max_vel);
+	}
+	//float min_vel
+	float min_vel() const {
+		return get<float>(offsets::min_vel);
+	}
+	//float obstacleRad
+	float obstacleRad() const {
+		return get<float>(offsets::obstacleRad);
+	}
+	//float step_height
+	float step_height() const {
+		return get<float>(offsets::step_height);
+	}
+	//float jump_speed
+	float jump_speed() const {
+		return get<float>(offsets::jump_speed);
+	}
+	//float fall_speed
+	float fall_speed() const {
+		return get<float>(offsets::fall_speed);
+	}
+	//short col_group
+	short col_group() const {
+		return get<short>(offsets::col_group);
+	}
+	//short col_mask
+	short col_mask() const {
+		return get<short>(offsets::col_mask);
+	}
+	//short rotmode
+	short rotmode() const {
+		return get<short>(offsets::rotmode);
+	}
+	//char boundtype
+	char boundtype() const {
+		return get<char>(offsets::boundtype);
+	}
+	//char collision_boundtype
+	char collision_boundtype() const {
+		return get<char>(offsets::collision_boundtype);
+	}
+	//short dtx
+	short dtx() const {
+		return get<short>(offsets::dtx);
+	}
+	//char dt
+	char dt() const {
+		return get<char>(offsets::dt);
+	}
+	//char empty_drawtype
+	char empty_drawtype() const {
+		return get<char>(offsets::empty_drawtype);
+	}
+	//float empty_drawsize
+	float empty_drawsize() const {
+		return get<float>(offsets::empty_drawsize);
+	}
+	//float dupfacesca
+	float dupfacesca() const {
+		return get<float>(offsets::dupfacesca);
+	}
+	//ListBase prop
+	const char* prop() const {
+		return at(offsets::prop);
+	}
+	//ListBase sensors
+	const char* sensors() const {
+		return at(offsets::sensors);
+	}
+	//ListBase controllers
+	const char* controllers() const {
+		return at(offsets::controllers);
+	}
+	//ListBase actuators
+	const char* actuators() const {
+		return at(offsets::actuators);
+	}
+	//float sf
+	float sf() const {
+		return get<float>(offsets::sf);
+	}
+	//short index
+	short index() const {
+		return get<short>(offsets::index);
+	}
+	//short actdef
+	short actdef() const {
+		return get<short>(offsets::actdef);
+	}
+	//float col[4]
+	float col(unsigned int i) const {
+		return get<float>(offsets::col + i * 4);
+	}
+	//int gameflag
+	int gameflag() const {
+		return get<int>(offsets::gameflag);
+	}
+	//int gameflag2
+	int gameflag2() const {
+		return get<int>(offsets::gameflag2);
+	}
+	//BulletSoftBody *bsoft
+	unsigned long bsoft() const {
+		return get<uint64_t>(offsets::bsoft);
+	}
+	//char restrictflag
+	char restrictflag() const {
+		return get<char>(offsets::restrictflag);
+	}
+	//char recalc
+	char recalc() const {
+		return get<char>(offsets::recalc);
+	}
+	//short softflag
+	short softflag() const {
+		return get<short>(offsets::softflag);
+	}
+	//float anisotropicFriction[3]
+	float anisotropicFriction(unsigned int i) const {
+		return get<float>(offsets::anisotropicFriction + i * 4);
+	}
+	//ListBase constraints
+	const char* constraints() const {
+		return at(offsets::constraints);
+	}
+	//ListBase nlastrips
+	const char* nlastrips() const {
+		return at(offsets::nlastrips);
+	}
+	//ListBase hooks
+	const char* hooks() const {
+		return at(offsets::hooks);
+	}
+	//ListBase particlesystem
+	const char* particlesystem() const {
+		return at(offsets::particlesystem);
+	}
+	//PartDeflect *pd
+	unsigned long pd() const {
+		return get<uint64_t>(offsets::pd);
+	}
+	//SoftBody *soft
+	unsigned long soft() const {
+		return get<uint64_t>(offsets::soft);
+	}
+	//Group *dup_group
+	unsigned long dup_group() const {
+		return get<uint64_t>(offsets::dup_group);
+	}
+	//char body_type
+	char body_type() const {
+		return get<char>(offsets::body_type);
+	}
+	//char shapeflag
+	char shapeflag() const {
+		return get<char>(offsets::shapeflag);
+	}
+	//short shapenr
+	short shapenr() const {
+		return get<short>(offsets::shapenr);
+	}
+	//float smoothresh
+	float smoothresh() const {
+		return get<float>(offsets::smoothresh);
+	}
+	//FluidsimSettings *fluidsimSettings
+	unsigned long fluidsimSettings() const {
+		return get<uint64_t>(offsets::fluidsimSettings);
+	}
+	//CurveCache *curve_cache
+	unsigned long curve_cache() const {
+		return get<uint64_t>(offsets::curve_cache);
+	}
+	//DerivedMesh *derivedDeform
+	unsigned long derivedDeform() const {
+		return get<uint64_t>(offsets::derivedDeform);
+	}
+	//DerivedMesh *derivedFinal
+	unsigned long derivedFinal() const {
+		return get<uint64_t>(offsets::derivedFinal);
+	}
+	//uint64_t lastDataMask
+	uint64_t lastDataMask() const {
+		return get<uint64_t>(offsets::lastDataMask);
+	}
+	//uint64_t customdata_mask
+	uint64_t customdata_mask() const {
+		return get<uint64_t>(offsets::customdata_mask);
+	}
+	//int state
+	int state() const {
+		return get<int>(offsets::state);
+	}
+	//int init_state
+	int init_state() const {
+		return get<int>(offsets::init_state);
+	}
+	//ListBase gpulamp
+	const char* gpulamp() const {
+		return at(offsets::gpulamp);
+	}
+	//ListBase pc_ids
+	const char* pc_ids() const {
+		return at(offsets::pc_ids);
+	}
+	//ListBase *duplilist
+	unsigned long duplilist() const {
+		return get<uint64_t>(offsets::duplilist);
+	}
+	//RigidBodyOb *rigidbody_object
+	unsigned long rigidbody_object() const {
+		return get<uint64_t>(offsets::rigidbody_object);
+	}
+	//RigidBodyCon *rigidbody_constraint
+	unsigned long rigidbody_constraint() const {
+		return get<uint64_t>(offsets::rigidbody_constraint);
+	}
+	//float ima_ofs[2]
+	float ima_ofs(unsigned int i) const {
+		return get<float>(offsets::ima_ofs + i * 4);
+	}
+	//ImageUser *iuser
+	unsigned long iuser() const {
+		return get<uint64_t>(offsets::iuser);
+	}
+	//ListBase lodlevels
+	const char* lodlevels() const {
+		return at(offsets::lodlevels);
+	}
+	//LodLevel *currentlod
+	unsigned long currentlod() const {
+		return get<uint64_t>(offsets::currentlod);
+	}
+
+	static const LayoutStruct& getLayout() {
+		static const LayoutField fields[] = {
+			{"id", "ID", 0},
+			{"*adt", "AnimData", 120},
+			{"*sculpt", "SculptSession", 128},
+			{"type", "short", 136},
+			{"partype", "short", 138},
+			{"par1", "int", 140},
+			{"par2", "int", 144},
+			{"par3", "int", 148},
+			{"parsubstr[64]", "char", 152},
+			{"*parent", "Object", 216},
+			{"*track", "Object", 224},
+			{"*proxy", "Object", 232},
+			{"*proxy_group", "Object", 240},
+			{"*proxy_from", "Object", 248},
+			{"*ipo", "Ipo", 256},
+			{"*bb", "BoundBox", 264},
+			{"*action", "bAction", 272},
+			{"*poselib", "bAction", 280},
+			{"*pose", "bPose", 288},
+			{"*data", "void", 296},
+			{"*gpd", "bGPdata", 304},
+			{"avs", "bAnimVizSettings", 312},
+			{"*mpath", "bMotionPath", 360},
+			{"constraintChannels", "ListBase", 368},
+			{"effect", "ListBase", 384},
+			{"defbase", "ListBase", 400},
+			{"modifiers", "ListBase", 416},
+			{"mode", "int", 432},
+			{"restore_mode", "int", 436},
+			{"**mat", "Material", 440},
+			{"*matbits", "char", 448},
+			{"totcol", "int", 456},
+			{"actcol", "int", 460},
+			{"loc[3]", "float", 464},
+			{"dloc[3]", "float", 476},
+			{"orig[3]", "float", 488},
+			{"size[3]", "float", 500},
+			{"dsize[3]", "float", 512},
+			{"dscale[3]", "float", 524},
+			{"rot[3]", "float", 536},
+			{"drot[3]", "float", 548},
+			{"quat[4]", "float", 560},
+			{"dquat[4]", "float", 576},
+			{"rotAxis[3]", "float", 592},
+			{"drotAxis[3]", "float", 604},
+			{"rotAngle", "float", 616},
+			{"drotAngle", "float", 620},
+			{"obmat[4][4]", "float", 624},
+			{"parentinv[4][4]", "float", 688},
+			{"constinv[4][4]", "float", 752},
+			{"imat[4][4]", "float", 816},
+			{"imat_ren[4][4]", "float", 880},
+			{"lay", "int", 944},
+			{"flag", "short", 948},
+			{"colbits", "short", 950},
+			{"transflag", "short", 952},
+			{"protectflag", "short", 954},
+			{"trackflag", "short", 956},
+			{"upflag", "short", 958},
+			{"nlaflag", "short", 960},
+			{"ipoflag", "short", 962},
+			{"scaflag", "short", 964},
+			{"scavisflag", "char", 966},
+			{"depsflag", "char", 967},
+			{"dupon", "int", 968},
+			{"dupoff", "int", 972},
+			{"dupsta", "int", 976},
+			{"dupend", "int", 980},
+			{"pad", "int", 984},
+			{"mass", "float", 988},
+			{"damping", "float", 992},
+			{"inertia", "float", 996},
+			{"formfactor", "float", 1000},
+			{"rdamping", "float", 1004},
+			{"margin", "float", 1008},
+			{"max_vel", "float", 1012},
+			{"min_vel", "float", 1016},
+			{"obstacleRad", "float", 1020},
+			{"step_height", "float", 1024},
+			{"jump_speed", "float", 1028},
+			{"fall_speed", "float", 1032},
+			{"col_group", "short", 1036},
+			{"col_mask", "short", 1038},
+			{"rotmode", "short", 1040},
+			{"boundtype", "char", 1042},
+			{"collision_boundtype", "char", 1043},
+			{"dtx", "short", 1044},
+			{"dt", "char", 1046},
+			{"empty_drawtype", "char", 1047},
+			{"empty_drawsize", "float", 1048},
+			{"dupfacesca", "float", 1052},
+			{"prop", "ListBase", 1056},
+			{"sensors", "ListBase", 1072},
+			{"controllers", "ListBase", 1088},
+			{"actuators", "ListBase", 1104},
+			{"sf", "float", 1120},
+			{"index", "short", 1124},
+			{"actdef", "short", 1126},
+			{"col[4]", "float", 1128},
+			{"gameflag", "int", 1144},
+			{"gameflag2", "int", 1148},
+			{"*bsoft", "BulletSoftBody", 1152},
+			{"restrictflag", "char", 1160},
+			{"recalc", "char", 1161},
+			{"softflag", "short", 1162},
+			{"anisotropicFriction[3]", "float", 1164},
+			{"constraints", "ListBase", 1176},
+			{"nlastrips", "ListBase", 1192},
+			{"hooks", "ListBase", 1208},
+			{"particlesystem", "ListBase", 1224},
+			{"*pd", "PartDeflect", 1240},
+			{"*soft", "SoftBody", 1248},
+			{"*dup_group", "Group", 1256},
+			{"body_type", "char", 1264},
+			{"shapeflag", "char", 1265},
+			{"shapenr", "short", 1266},
+			{"smoothresh", "float", 1268},
+			{"*fluidsimSettings", "FluidsimSettings", 1272},
+			{"*curve_cache", "CurveCache", 1280},
+			{"*derivedDeform", "DerivedMesh", 1288},
+			{"*derivedFinal", "DerivedMesh", 1296},
+			{"lastDataMask", "uint64_t", 1304},
+			{"customdata_mask", "uint64_t", 1312},
+			{"state", "int", 1320},
+			{"init_state", "int", 1324},
+			{"gpulamp", "ListBase", 1328},
+			{"pc_ids", "ListBase", 1344},
+			{"*duplilist", "ListBase", 1360},
+			{"*rigidbody_object", "RigidBodyOb", 1368},
+			{"*rigidbody_constraint", "RigidBodyCon", 1376},
+			{"ima_ofs[2]", "float", 1384},
+			{"*iuser", "ImageUser", 1392},
+			{"lodlevels", "ListBase", 1400},
+			{"*currentlod", "LodLevel", 1416}
+		};
+		static const LayoutStruct layout = {"Object", structSize, fields, 134};
+		return layout;
+	}
+};
+
+class BezTriple: public StructView {
+public:
+	static constexpr unsigned int layoutIndex = 1;
+	static constexpr unsigned int structSize = 72;
+
+	struct offsets {
+		static constexpr unsigned int vec = 0;
+		static constexpr unsigned int alfa = 36;
+		static constexpr unsigned int weight = 40;
+		static constexpr unsigned int radius = 44;
+		static constexpr unsigned int ipo = 48;
+		static constexpr unsigned int h1 = 49;
+		static constexpr unsigned int h2 = 50;
+		static constexpr unsigned int f1 = 51;
+		static constexpr unsigned int f2 = 52;
+		static constexpr unsigned int f3 = 53;
+		static constexpr unsigned int hide = 54;
+		static constexpr unsigned int easing = 55;
+		static constexpr unsigned int back = 56;
+		static constexpr unsigned int amplitude = 60;
+		static constexpr unsigned int period = 64;
+		static constexpr unsigned int pad = 68;
+	};
+
+	BezTriple(const char* bytes=NULL): StructView(bytes) {}
+
+	BezTriple operator[](unsigned int index) const {
+		return BezTriple(bytes + index * structSize);
+	}
+
+	//float vec[3][3]
+	float vec(unsigned int i, unsigned int j) const {
+		return get<float>(offsets::vec + (i * 3 + j) * 4);
+	}
+	//float alfa
+	float alfa() const {
+		return get<float>(offsets::alfa);
+	}
+	//float weight
+	float weight() const {
+		return get<float>(offsets::weight);
+	}
+	//float radius
+	float radius() const {
+		return get<float>(offsets::radius);
+	}
+	//char ipo
+	char ipo() const {
+		return get<char>(offsets::ipo);
+	}
+	//char h1
+	char h1() const {
+		return get<char>(offsets::h1);
+	}
+	//char h2
+	char h2() const {
+		return get<char>(offsets::h2);
+	}
+	//char f1
+	char f1() const {
+		return get<char>(offsets::f1);
+	}
+	//char f2
+	char f2() const {
+		return get<char>(offsets::f2);
+	}
+	//char f3
+	char f3() const {
+		return get<char>(offsets::f3);
+	}
+	//char hide
+	char hide() const {
+		return get<char>(offsets::hide);
+	}
+	//char easing
+	char easing() const {
+		return get<char>(offsets::easing);
+	}
+	//float back
+	float back() const {
+		return get<float>(offsets::back);
+	}
+	//float amplitude
+	float amplitude() const {
+		return get<float>(offsets::amplitude);
+	}
+	//float period
+	float period() const {
+		return get<float>(offsets::period);
+	}
+	//char pad[4]
+	const char* pad() const {
+		return at(offsets::pad);
+	}
+
+	static const LayoutStruct& getLayout() {
+		static const LayoutField fields[] = {
+			{"vec[3][3]", "float", 0},
+			{"alfa", "float", 36},
+			{"weight", "float", 40},
+			{"radius", "float", 44},
+			{"ipo", "char", 48},
+			{"h1", "char", 49},
+			{"h2", "char", 50},
+			{"f1", "char", 51},
+			{"f2", "char", 52},
+			{"f3", "char", 53},
+			{"hide", "char", 54},
+			{"easing", "char", 55},
+			{"back", "float", 56},
+			{"amplitude", "float", 60},
+			{"period", "float", 64},
+			{"pad[4]", "char", 68}
+		};
+		static const LayoutStruct layout = {"BezTriple", structSize, fields, 16};
+		return layout;
+	}
+};
+
+class FCurve: public StructView {
+public:
+	static constexpr unsigned int layoutIndex = 2;
+	static constexpr unsigned int structSize = 112;
+
+	struct offsets {
+		static constexpr unsigned int next = 0;
+		static constexpr unsigned int prev = 8;
+		static constexpr unsigned int grp = 16;
+		static constexpr unsigned int driver = 24;
+		static constexpr unsigned int modifiers = 32;
+		static constexpr unsigned int bezt = 48;
+		static constexpr unsigned int fpt = 56;
+		static constexpr unsigned int totvert = 64;
+		static constexpr unsigned int curval = 68;
+		static constexpr unsigned int flag = 72;
+		static constexpr unsigned int extend = 74;
+		static constexpr unsigned int array_index = 76;
+		static constexpr unsigned int rna_path = 80;
+		static constexpr unsigned int color_mode = 88;
+		static constexpr unsigned int color = 92;
+		static constexpr unsigned int prev_norm_factor = 104;
+		static constexpr unsigned int pad = 108;
+	};
+
+	FCurve(const char* bytes=NULL): StructView(bytes) {}
+
+	FCurve operator[](unsigned int index) const {
+		return FCurve(bytes + index * structSize);
+	}
+
+	//FCurve *next
+	unsigned long next() const {
+		return get<uint64_t>(offsets::next);
+	}
+	//FCurve *prev
+	unsigned long prev() const {
+		return get<uint64_t>(offsets::prev);
+	}
+	//bActionGroup *grp
+	unsigned long grp() const {
+		return get<uint64_t>(offsets::grp);
+	}
+	//ChannelDriver *driver
+	unsigned long driver() const {
+		return get<uint64_t>(offsets::driver);
+	}
+	//ListBase modifiers
+	const char* modifiers() const {
+		return at(offsets::modifiers);
+	}
+	//BezTriple *bezt
+	unsigned long bezt() const {
+		return get<uint64_t>(offsets::bezt);
+	}
+	//FPoint *fpt
+	unsigned long fpt() const {
+		return get<uint64_t>(offsets::fpt);
+	}
+	//int totvert
+	int totvert() const {
+		return get<int>(offsets::totvert);
+	}
+	//float curval
+	float curval() const {
+		return get<float>(offsets::curval);
+	}
+	//short flag
+	short flag() const {
+		return get<short>(offsets::flag);
+	}
+	//short extend
+	short extend() const {
+		return get<short>(offsets::extend);
+	}
+	//int array_index
+	int array_index() const {
+		return get<int>(offsets::array_index);
+	}
+	//char *rna_path
+	unsigned long rna_path() const {
+		return get<uint64_t>(offsets::rna_path);
+	}
+	//int color_mode
+	int color_mode() const {
+		return get<int>(offsets::color_mode);
+	}
+	//float color[3]
+	float color(unsigned int i) const {
+		return get<float>(offsets::color + i * 4);
+	}
+	//float prev_norm_factor
+	float prev_norm_factor() const {
+		return get<float>(offsets::prev_norm_factor);
+	}
+	//float pad
+	float pad() const {
+		return get<float>(offsets::pad);
+	}
+
+	static const LayoutStruct& getLayout() {
+		static const LayoutField fields[] = {
+			{"*next", "FCurve", 0},
+			{"*prev", "FCurve", 8},
+			{"*grp", "bActionGroup", 16},
+			{"*driver", "ChannelDriver", 24},
+			{"modifiers", "ListBase", 32},
+			{"*bezt", "BezTriple", 48},
+			{"*fpt", "FPoint", 56},
+			{"totvert", "int", 64},
+			{"curval", "float", 68},
+			{"flag", "short", 72},
+			{"extend", "short", 74},
+			{"array_index", "int", 76},
+			{"*rna_path", "char", 80},
+			{"color_mode", "int", 88},
+			{"color[3]", "float", 92},
+			{"prev_norm_factor", "float", 104},
+			{"pad", "float", 108}
+		};
+		static const LayoutStruct layout = {"FCurve", structSize, fields, 17};
+		return layout;
+	}
+};
+
+const unsigned int numLayouts = 3;
+
+inline const LayoutStruct& getLayout(unsigned int index) {
+	static const LayoutStruct* layouts[] = {
+		&Object::getLayout(),
+		&BezTriple::getLayout(),
+		&FCurve::getLayout()
+	};
+	return *layouts[index];
+}
+
+}
+}
+}
+
+#endif // BLENDER_GENERATEDLAYOUT_H
@@ -0,0 +1,56 @@
+#ifndef BLENDER_LAYOUT_H
+#define BLENDER_LAYOUT_H
+
+#include <cstring>
+#include <stdint.h>
+
+namespace ofx {
+namespace blender {
+
+//a field of a generated layout, name and type as they appear in the DNA catalog
+struct LayoutField {
+	const char* name;
+	const char* type;
+	unsigned int offset;
+};
+
+struct LayoutStruct {
+	const char* name;
+	unsigned int size;
+	const LayoutField* fields;
+	unsigned int numFields;
+};
+
+//typed access to the bytes of a structure, the offsets come from a layout generated with File::exportLayout
+//views are only handed out when the layout of the loaded file matches the generated one
+class StructView {
+public:
+	StructView(const char* bytes=NULL): bytes(bytes) {}
+
+	bool isValid() const {
+		return bytes != NULL;
+	}
+
+	const char* getBytes() const {
+		return bytes;
+	}
+
+protected:
+	template<typename Type>
+	Type get(unsigned int offset) const {
+		Type ret;
+		memcpy(&ret, bytes + offset, sizeof(Type));
+		return ret;
+	}
+
+	const char* at(unsigned int offset) const {
+		return bytes + offset;
+	}
+
+	const char* bytes;
+};
+
+}
+}
+
+#endif // BLENDER_LAYOUT_H
@@ -0,0 +1,58 @@
+#include "LoadFilter.h"
+
+namespace ofx {
+namespace blender {
+
+LoadFilter::LoadFilter() {
+	clear();
+}
+
+void LoadFilter::clear() {
+	sceneName = "";
+	objects.clear();
+	types.clear();
+	skipMeshData = false;
+	boundsOnly = false;
+	skipTextures = false;
+	reachableOnly = false;
+}
+
+bool LoadFilter::matchesObject(const string& name) const {
+	if(objects.empty())
+		return true;
+	for(const string& pattern: objects) {
+		if(matchPattern(pattern, name))
+			return true;
+	}
+	return false;
+}
+
+bool LoadFilter::matchesType(ObjectType type) const {
+	return types.empty() || types.find(type) != types.end();
+}
+
+bool LoadFilter::matchPattern(const string& pattern, const string& name) {
+	//iterative wildcard match, backtracks to the last * on a mismatch
+	size_t p = 0, n = 0;
+	size_t star = string::npos, starName = 0;
+	while(n < name.size()) {
+		if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+			p++;
+			n++;
+		} else if(p < pattern.size() && pattern[p] == '*') {
+			star = p++;
+			starName = n;
+		} else if(star != string::npos) {
+			p = star + 1;
+			n = ++starName;
+		} else {
+			return false;
+		}
+	}
+	while(p < pattern.size() && pattern[p] == '*')
+		p++;
+	return p == pattern.size();
+}
+
+}
+}
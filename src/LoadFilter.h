@@ -0,0 +1,48 @@
+#ifndef LOADFILTER_H
+#define LOADFILTER_H
+
+#include "Object.h"
+#include <set>
+
+namespace ofx {
+namespace blender {
+
+//restricts what is parsed from a file, set File::filter before getting a scene, e.g. only the cameras:
+//
+//	file.filter.types.insert(CAMERA);
+//	Scene* scene = file.getScene();
+class LoadFilter {
+public:
+	LoadFilter();
+
+	//loads everything again
+	void clear();
+
+	bool matchesObject(const string& name) const;
+	bool matchesType(ObjectType type) const;
+
+	//* matches any number of characters, ? a single one
+	static bool matchPattern(const string& pattern, const string& name);
+
+	//scene returned by File::getScene() and loaded by File::loadAsync without a name, the first scene if empty
+	string sceneName;
+	//names or patterns of the objects to load, all objects if empty
+	std::vector<string> objects;
+	//types of the objects to load, all types if empty
+	std::set<ObjectType> types;
+	//meshes are created without vertices, faces and materials
+	bool skipMeshData;
+	//meshes only get their bounds, without faces and materials
+	bool boundsOnly;
+	//materials are loaded without their textures
+	bool skipTextures;
+	//only blocks reachable from the scene (all scenes if sceneName is empty) are kept when the file is loaded,
+	//UI and editor blocks and unused datablocks are dropped, has to be set before File::load. the whole file is
+	//still read, the pointers can only be followed once the DNA at its end is known, this only saves memory
+	bool reachableOnly;
+};
+
+}
+}
+
+#endif // LOADFILTER_H
@@ -0,0 +1,109 @@
+#include "LoadHandle.h"
+
+namespace ofx {
+namespace blender {
+
+LoadHandle::LoadHandle(File* file, string path, string sceneName) {
+	this->file = file;
+	this->sceneName = sceneName;
+	sceneBlock = NULL;
+	scene = NULL;
+	state = LOADING;
+	detachedProgress.reset();
+	thread = std::thread(&LoadHandle::run, this, path);
+}
+
+LoadHandle::~LoadHandle() {
+	if(thread.joinable())
+		thread.join();
+}
+
+void LoadHandle::run(string path) {
+	if(!file->load(path)) {
+		state = FAILED;
+		return;
+	}
+
+	if(sceneName.empty())
+		sceneBlock = file->getBlocksByType(BL_SCENE, 0);
+	else
+		sceneBlock = file->getBlockByName("SC", sceneName);
+	if(sceneBlock == NULL) {
+		ofLogWarning(OFX_BLENDER) << "Could not find scene \"" << sceneName << "\" in " << path;
+		state = FAILED;
+		return;
+	}
+
+	//the scene graph is linked here as well, cameras, lights, textures and meshes stay queued for finalize
+	scene = file->parseScene(sceneBlock, false);
+	if(scene == NULL) {
+		state = FAILED;
+		return;
+	}
+	state = PARSED;
+}
+
+bool LoadHandle::isParsed() {
+	return state == PARSED || state == FINISHED;
+}
+
+bool LoadHandle::isFinished() {
+	return state == FINISHED;
+}
+
+bool LoadHandle::hasFailed() {
+	return state == FAILED;
+}
+
+const LoadProgress& LoadHandle::getProgress() {
+	if(file == NULL)
+		return detachedProgress;
+	return file->getProgress();
+}
+
+float LoadHandle::getProgressPercent() {
+	if(state == FINISHED)
+		return 1;
+	const LoadProgress& progress = getProgress();
+	//reading the file and building the meshes are weighted the same
+	float read = progress.bytesTotal > 0 ? float(progress.bytesRead) / progress.bytesTotal : 0;
+	float built = progress.meshesTotal > 0 ? float(progress.meshesBuilt) / progress.meshesTotal : read;
+	return ofClamp((read + built) * 0.5, 0, 0.99);
+}
+
+bool LoadHandle::finalize(float maxMillis) {
+	if(state == FINISHED)
+		return true;
+	if(state != PARSED)
+		return false;
+
+	unsigned long long startTime = ofGetElapsedTimeMicros();
+	if(thread.joinable())
+		thread.join();
+
+	//cameras and lights are set up here as well, they touch GL state
+	do {
+		if(!file->uploadNext()) {
+			state = FINISHED;
+			return true;
+		}
+	} while(ofGetElapsedTimeMicros() - startTime < maxMillis * 1000);
+	return false;
+}
+
+void LoadHandle::detach() {
+	if(thread.joinable())
+		thread.join();
+	file = NULL;
+	scene = NULL;
+	state = FAILED;
+}
+
+Scene* LoadHandle::getScene() {
+	if(state != FINISHED)
+		return NULL;
+	return scene;
+}
+
+}
+}
@@ -0,0 +1,69 @@
+#ifndef LOADHANDLE_H
+#define LOADHANDLE_H
+
+#include "File.h"
+
+namespace ofx {
+namespace blender {
+
+//result of File::loadAsync. the file is loaded and the scene is parsed and linked on background threads, finalize()
+//then sets up cameras and lights and uploads to the graphics card in small slices, e.g.
+//
+//	void update() {
+//		if(handle && handle->finalize(4))
+//			scene = handle->getScene();
+//	}
+//
+//the handle keeps a pointer to the file, destroying the file or loading again waits for the background thread and
+//the handle fails from then on
+class LoadHandle {
+public:
+	LoadHandle(File* file, string path, string sceneName);
+	~LoadHandle();
+
+	//background parsing is done, finalize() can upload
+	bool isParsed();
+	//the scene is linked and everything is uploaded
+	bool isFinished();
+	bool hasFailed();
+
+	const LoadProgress& getProgress();
+	//rough overall progress from 0 to 1
+	float getProgressPercent();
+
+	//has to be called from the GL thread, spends at most maxMillis (but always uploads at least one item)
+	//and returns true once the scene is finished
+	bool finalize(float maxMillis=4);
+	//NULL until finished or once the file is gone
+	Scene* getScene();
+
+private:
+	LoadHandle(const LoadHandle&);
+	LoadHandle& operator=(const LoadHandle&);
+
+	enum State {
+		LOADING,
+		PARSED,
+		FINISHED,
+		FAILED
+	};
+
+	void run(string path);
+	//called by the file when it is destroyed or loads again
+	void detach();
+
+	File* file;
+	string sceneName;
+	File::Block* sceneBlock;
+	Scene* scene;
+	std::atomic<int> state;
+	std::thread thread;
+	LoadProgress detachedProgress;
+
+	friend class File;
+};
+
+}
+}
+
+#endif // LOADHANDLE_H
@@ -0,0 +1,92 @@
+#include "MemoryReport.h"
+
+namespace ofx {
+namespace blender {
+
+std::vector<MemoryReport::Item> MemoryReport::Category::getTop(unsigned int numItems) const {
+	std::vector<Item> top = items;
+	numItems = std::min<size_t>(numItems, top.size());
+	std::partial_sort(top.begin(), top.begin() + numItems, top.end(), [](const Item& i1, const Item& i2) {
+		return i1.bytes > i2.bytes;
+	});
+	top.resize(numItems);
+	return top;
+}
+
+MemoryReport::MemoryReport() {
+	static const char* names[NUM_CATEGORIES] = {
+		"file data", "dna catalog", "block index", "mesh data", "part meshes",
+		"gpu buffers", "texture pixels", "gpu textures", "keyframes", "names"
+	};
+	for(unsigned int i=0; i<NUM_CATEGORIES; i++)
+		categories[i].name = names[i];
+}
+
+void MemoryReport::add(CategoryType type, const string& itemName, size_t bytes) {
+	Category& category = categories[type];
+	category.bytes += bytes;
+	category.count++;
+	Item item = {itemName, bytes};
+	category.items.push_back(item);
+}
+
+void MemoryReport::merge(const MemoryReport& report) {
+	for(unsigned int i=0; i<NUM_CATEGORIES; i++) {
+		for(const Item& item: report.categories[i].items)
+			add(CategoryType(i), item.name, item.bytes);
+	}
+}
+
+const MemoryReport::Category& MemoryReport::getCategory(CategoryType type) const {
+	return categories[type];
+}
+
+size_t MemoryReport::getBytes(CategoryType type) const {
+	return categories[type].bytes;
+}
+
+size_t MemoryReport::getTotalBytes() const {
+	return getCpuBytes() + getGpuBytes();
+}
+
+size_t MemoryReport::getCpuBytes() const {
+	size_t bytes = 0;
+	for(unsigned int i=0; i<NUM_CATEGORIES; i++) {
+		if(!isGpu(CategoryType(i)))
+			bytes += categories[i].bytes;
+	}
+	return bytes;
+}
+
+size_t MemoryReport::getGpuBytes() const {
+	return categories[GPU_BUFFERS].bytes + categories[GPU_TEXTURES].bytes;
+}
+
+bool MemoryReport::isGpu(CategoryType type) {
+	return type == GPU_BUFFERS || type == GPU_TEXTURES;
+}
+
+static string formatBytes(size_t bytes) {
+	if(bytes >= 1024 * 1024)
+		return ofToString(bytes / (1024.f * 1024.f), 2) + " MB";
+	if(bytes >= 1024)
+		return ofToString(bytes / 1024.f, 1) + " KB";
+	return ofToString(bytes) + " B";
+}
+
+string MemoryReport::toString(unsigned int numItems) const {
+	std::stringstream out;
+	out << "cpu " << formatBytes(getCpuBytes()) << ", gpu " << formatBytes(getGpuBytes()) << endl;
+	for(unsigned int i=0; i<NUM_CATEGORIES; i++) {
+		const Category& category = categories[i];
+		out << category.name << ": " << formatBytes(category.bytes) << " in " << category.count << " items";
+		std::vector<Item> top = category.getTop(numItems);
+		for(unsigned int j=0; j<top.size(); j++)
+			out << (j == 0 ? " (" : ", ") << top[j].name << " " << formatBytes(top[j].bytes);
+		out << (top.empty() ? "" : ")") << endl;
+	}
+	return out.str();
+}
+
+}
+}
@@ -0,0 +1,83 @@
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include "Utils.h"
+
+namespace ofx {
+namespace blender {
+
+//bytes used by a file or scene, split into categories with the biggest items of each, see File::getMemoryReport
+//and Scene::getMemoryReport. numbers are estimates from container sizes, allocator overhead is not included
+class MemoryReport {
+public:
+	enum CategoryType {
+		//blend file bytes in memory (mapped or decompressed)
+		FILE_DATA,
+		DNA_CATALOG,
+		BLOCK_INDEX,
+		//vertices, normals and triangles kept by the meshes
+		MESH_DATA,
+		//the ofMesh copies of the mesh parts
+		PART_MESHES,
+		GPU_BUFFERS,
+		TEXTURE_PIXELS,
+		GPU_TEXTURES,
+		KEYFRAMES,
+		NAMES,
+		NUM_CATEGORIES
+	};
+
+	struct Item {
+		string name;
+		size_t bytes;
+	};
+
+	class Category {
+	public:
+		Category(): bytes(0), count(0) {}
+
+		//the biggest items first
+		std::vector<Item> getTop(unsigned int numItems) const;
+
+		string name;
+		size_t bytes;
+		size_t count;
+		std::vector<Item> items;
+	};
+
+	MemoryReport();
+
+	//adds the bytes of one item, e.g. the vertices of a mesh
+	void add(CategoryType type, const string& itemName, size_t bytes);
+	void merge(const MemoryReport& report);
+
+	const Category& getCategory(CategoryType type) const;
+	size_t getBytes(CategoryType type) const;
+	size_t getTotalBytes() const;
+	size_t getCpuBytes() const;
+	size_t getGpuBytes() const;
+
+	//one line per category with the numItems biggest items
+	string toString(unsigned int numItems=5) const;
+
+	static bool isGpu(CategoryType type);
+
+	//bytes of a vector's storage
+	template<typename Type>
+	static size_t getBytes(const std::vector<Type>& values) {
+		return values.capacity() * sizeof(Type);
+	}
+
+	//the string itself and its characters if they don't fit into it
+	static size_t getBytes(const string& value) {
+		return sizeof(string) + (value.capacity() > 15 ? value.capacity() + 1 : 0);
+	}
+
+private:
+	Category categories[NUM_CATEGORIES];
+};
+
+}
+}
+
+#endif // MEMORYREPORT_H
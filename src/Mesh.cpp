@@ -1,4 +1,6 @@
 #include "Mesh.h"
+#include <unordered_map>
+#include <cstring>
 
 namespace ofx {
 namespace blender {
@@ -8,8 +10,9 @@ Mesh::Mesh() {
 	curMaterial = NULL;
 	isTwoSided = true;
 	boundsMin.set(std::numeric_limits<float>::max());
-	boundsMax.set(std::numeric_limits<float>::min());
+	boundsMax.set(std::numeric_limits<float>::lowest());
 	isTransparent = false;
+	built = false;
 }
 
 Mesh::~Mesh() {
@@ -82,26 +85,32 @@ void Mesh::addTriangle(Triangle triangle) {
 	triangles.push_back(triangle);
 }
 
-void Mesh::addVertex(ofVec3f pos, ofVec3f norm) {
-
-	if(boundsMin.x > pos.x)
-		boundsMin.x = pos.x;
-	if(boundsMin.y > pos.y)
-		boundsMin.y = pos.y;
-	if(boundsMin.z > pos.z)
-		boundsMin.z = pos.z;
-
-	if(boundsMax.x < pos.x)
-		boundsMax = pos;
-	if(boundsMax.y < pos.y)
-		boundsMax.y = pos.y;
-	if(boundsMax.z < pos.z)
-		boundsMax.z = pos.z;
+void Mesh::reserveTriangles(unsigned int count) {
+	triangles.reserve(triangles.size() + count);
+}
 
+void Mesh::addVertex(ofVec3f pos, ofVec3f norm) {
+	boundsMin.set(std::min(boundsMin.x, pos.x), std::min(boundsMin.y, pos.y), std::min(boundsMin.z, pos.z));
+	boundsMax.set(std::max(boundsMax.x, pos.x), std::max(boundsMax.y, pos.y), std::max(boundsMax.z, pos.z));
 	vertices.push_back(pos);
 	normals.push_back(norm);
 }
 
+void Mesh::setVertices(Vec3Array& positions, Vec3Array& norms) {
+	vertices.swap(positions);
+	normals.swap(norms);
+	normals.resize(vertices.size());
+	boundsMin.set(std::numeric_limits<float>::max());
+	boundsMax.set(std::numeric_limits<float>::lowest());
+	vertices.getBounds(boundsMin, boundsMax);
+}
+
+bool Mesh::getGlobalBounds(ofVec3f& min, ofVec3f& max) {
+	Vec3Array transformed;
+	vertices.getTransformed(getGlobalTransformMatrix(), transformed);
+	return transformed.getBounds(min, max);
+}
+
 void Mesh::addMesh(ofMesh& mesh) {
 	std::vector<ofVec3f>& verts = mesh.getVertices();
 	std::vector<ofVec3f>& normals = mesh.getNormals();
@@ -144,12 +153,20 @@ void Mesh::addMesh(ofMesh& mesh) {
 }
 
 
-ofVec3f& Mesh::getVertex(unsigned int pos) {
-	return vertices[pos];
+ofVec3f Mesh::getVertex(unsigned int pos) {
+	return vertices.get(pos);
 }
 
-ofVec3f& Mesh::getNormal(unsigned int pos) {
-	return normals[pos];
+ofVec3f Mesh::getNormal(unsigned int pos) {
+	return normals.get(pos);
+}
+
+unsigned int Mesh::getNumVertices() {
+	return vertices.size();
+}
+
+unsigned int Mesh::getNumTriangles() {
+	return triangles.size();
 }
 
 /*
@@ -188,47 +205,103 @@ void Mesh::pushShading(Shading shading) {
 	curShading = shading;
 }
 
+//a corner of a part triangle, corners with the same vertex, uv and (for flat parts) face normal share one part vertex.
+//flat normals are compared quantized, so the triangles of a planar polygon share their corners
+struct PartVertexKey {
+	unsigned int vertex;
+	short normal[3];
+	float uv[2];
+
+	bool operator==(const PartVertexKey& other) const {
+		return vertex == other.vertex && normal[0] == other.normal[0] && normal[1] == other.normal[1] && normal[2] == other.normal[2]
+		       && uv[0] == other.uv[0] && uv[1] == other.uv[1];
+	}
+};
+
+struct PartVertexHash {
+	size_t operator()(const PartVertexKey& key) const {
+		unsigned int u, v;
+		memcpy(&u, &key.uv[0], sizeof(float));
+		memcpy(&v, &key.uv[1], sizeof(float));
+		size_t hash = key.vertex * 0x9e3779b1u;
+		hash ^= (u + 0x7f4a7c15u + (hash << 6) + (hash >> 2));
+		hash ^= (v + 0x7f4a7c15u + (hash << 6) + (hash >> 2));
+		hash ^= ((unsigned short)key.normal[0] | ((unsigned short)key.normal[1] << 16)) + (hash << 6) + (hash >> 2);
+		hash ^= (unsigned short)key.normal[2] + (hash << 6) + (hash >> 2);
+		return hash;
+	}
+};
+
+typedef std::unordered_map<PartVertexKey, ofIndexType, PartVertexHash> PartVertexMap;
+
 void Mesh::build() {
 	clear();
-	for(Triangle& tri: triangles) {
+
+	//flat normals of all triangles in one pass
+	Vec3Array faceNormals;
+	bool hasFlatTriangles = false;
+	for(Triangle& tri: triangles)
+		hasFlatTriangles = hasFlatTriangles || tri.shading == FLAT;
+	if(hasFlatTriangles) {
+		std::vector<unsigned int> corners(triangles.size() * 3);
+		for(unsigned int i=0; i<triangles.size(); i++) {
+			corners[i * 3] = triangles[i].a;
+			corners[i * 3 + 1] = triangles[i].b;
+			corners[i * 3 + 2] = triangles[i].c;
+		}
+		faceNormals.setFaceNormals(vertices, corners);
+	}
+
+	//one lookup of the emitted vertices per part
+	std::vector<PartVertexMap> partVertices;
+	for(unsigned int t=0; t<triangles.size(); t++) {
+		Triangle& tri = triangles[t];
 		Part& part = getPart(tri.material, tri.shading, true);
 		part.hasTriangles = true;
+		unsigned int partIndex = &part - &parts[0];
+		if(partIndex >= partVertices.size()) {
+			partVertices.resize(partIndex + 1);
+			partVertices[partIndex].reserve(triangles.size());
+		}
+		PartVertexMap& lookup = partVertices[partIndex];
 
 		ofMesh& mesh = part.primitive.getMesh();
 
-		//if(tri.uvs.size() > 0) {
-
-		//TODO: currently each triangle is uploaded  separately, could be optimized, at least for meshes without UVs
-		unsigned int curIndex = mesh.getNumVertices();
-
-		ofVec3f v0 = vertices[tri.a];
-		ofVec3f v1 = vertices[tri.b];
-		ofVec3f v2 = vertices[tri.c];
-
-		mesh.addVertex(v0);
-		mesh.addVertex(v1);
-		mesh.addVertex(v2);
-
-		if(part.shading == FLAT) {
-			ofVec3f n = (v1 - v2).crossed(v2-v0).normalized();
-			mesh.addNormal(n);
-			mesh.addNormal(n);
-			mesh.addNormal(n);
-		} else {
-			ofVec3f n0 = normals[tri.a];
-			ofVec3f n1 = normals[tri.b];
-			ofVec3f n2 = normals[tri.c];
-			mesh.addNormal(n0);
-			mesh.addNormal(n1);
-			mesh.addNormal(n2);
+		unsigned int corners[3] = {tri.a, tri.b, tri.c};
+		ofVec2f uvs[3];
+		bool hasUvs = tri.uvs.size() > 0;
+		if(hasUvs) {
+			uvs[0] = tri.uvs[0].a;
+			uvs[1] = tri.uvs[0].b;
+			uvs[2] = tri.uvs[0].c;
 		}
 
-		if(tri.uvs.size() > 0) {
-			mesh.addTexCoord(tri.uvs[0].a);
-			mesh.addTexCoord(tri.uvs[0].b);
-			mesh.addTexCoord(tri.uvs[0].c);
+		ofVec3f faceNormal;
+		if(part.shading == FLAT)
+			faceNormal = faceNormals.get(t);
+
+		ofIndexType indices[3];
+		for(unsigned int i=0; i<3; i++) {
+			PartVertexKey key;
+			key.vertex = corners[i];
+			key.normal[0] = key.normal[1] = key.normal[2] = 0;
+			if(part.shading == FLAT) {
+				for(unsigned int j=0; j<3; j++)
+					key.normal[j] = roundf(faceNormal[j] * 32767);
+			}
+			key.uv[0] = uvs[i].x;
+			key.uv[1] = uvs[i].y;
+
+			std::pair<PartVertexMap::iterator, bool> inserted = lookup.insert(std::make_pair(key, (ofIndexType)mesh.getNumVertices()));
+			if(inserted.second) {
+				mesh.addVertex(vertices.get(corners[i]));
+				mesh.addNormal(part.shading == FLAT ? faceNormal : normals.get(corners[i]));
+				if(hasUvs)
+					mesh.addTexCoord(uvs[i]);
+			}
+			indices[i] = inserted.first->second;
 		}
-		mesh.addTriangle(curIndex, curIndex+1, curIndex+2);
+		mesh.addTriangle(indices[0], indices[1], indices[2]);
 
 		//add the material to the used materials
 		if(part.material && std::find(materials.begin(), materials.end(), part.material)==materials.end())
@@ -275,6 +348,62 @@ void Mesh::build() {
 	if(tCount > triangles.size() * .1){
 		isTransparent = true;
 	}	
+	built = true;
+}
+
+bool Mesh::isBuilt() {
+	return built;
+}
+
+void Mesh::buildAll(const std::vector<Mesh*>& meshes, unsigned int numThreads, std::function<void(Mesh*)> build) {
+	std::vector<size_t> numTriangles(meshes.size());
+	for(unsigned int i=0; i<meshes.size(); i++)
+		numTriangles[i] = meshes[i]->getNumTriangles();
+	std::vector<unsigned int> order(meshes.size());
+	for(unsigned int i=0; i<order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+		return numTriangles[a] > numTriangles[b];
+	});
+
+	parallelFor(order.size(), [&](unsigned int i) {
+		if(build)
+			build(meshes[order[i]]);
+		else
+			meshes[order[i]]->build();
+	}, numThreads);
+}
+
+void Mesh::upload() {
+	for(Part& part: parts) {
+		if(part.hasTriangles)
+			part.upload();
+	}
+}
+
+void Mesh::addMemoryUsage(MemoryReport& report) {
+	size_t meshData = vertices.getNumBytes() + normals.getNumBytes() + MemoryReport::getBytes(triangles);
+	for(Triangle& triangle: triangles)
+		meshData += MemoryReport::getBytes(triangle.uvs);
+
+	size_t partMeshes = 0;
+	size_t gpuBuffers = 0;
+	for(Part& part: parts) {
+		meshData += MemoryReport::getBytes(part.polys);
+		ofMesh& mesh = part.primitive.getMesh();
+		partMeshes += MemoryReport::getBytes(mesh.getVertices()) + MemoryReport::getBytes(mesh.getNormals());
+		partMeshes += MemoryReport::getBytes(mesh.getTexCoords()) + MemoryReport::getBytes(mesh.getIndices());
+		//parts are uploaded when they are drawn the first time
+		if(part.hasTriangles) {
+			gpuBuffers += mesh.getNumVertices() * sizeof(ofVec3f) + mesh.getNumNormals() * sizeof(ofVec3f);
+			gpuBuffers += mesh.getNumTexCoords() * sizeof(ofVec2f) + mesh.getNumIndices() * sizeof(ofIndexType);
+		}
+	}
+
+	report.add(MemoryReport::MESH_DATA, name, meshData);
+	report.add(MemoryReport::PART_MESHES, name, partMeshes);
+	report.add(MemoryReport::GPU_BUFFERS, name, gpuBuffers);
+	report.add(MemoryReport::NAMES, name, MemoryReport::getBytes(name) + MemoryReport::getBytes(meshName));
 }
 
 void Mesh::clear() {
@@ -329,6 +458,11 @@ void Mesh::exportUVs(int h, int w, unsigned int layer, string path) {
 
 
 //////////////////////////////// DRAWING
+void Mesh::Part::upload() {
+	vbo.setMesh(primitive.getMesh(), GL_STATIC_DRAW);
+	isUploaded = true;
+}
+
 void Mesh::Part::draw() {
 	if(shading == FLAT)
 		glShadeModel(GL_FLAT);
@@ -340,7 +474,10 @@ void Mesh::Part::draw() {
 	else
 		ofSetColor(255);
 
-	primitive.draw(OF_MESH_FILL);
+	if(isUploaded)
+		vbo.drawElements(GL_TRIANGLES, vbo.getNumIndices());
+	else
+		primitive.draw(OF_MESH_FILL);
 
 	if(material != NULL)
 		material->end();
@@ -3,6 +3,7 @@
 
 #include "Object.h"
 #include "Material.h"
+#include "Vec3Array.h"
 
 namespace ofx {
 namespace blender {
@@ -35,6 +36,8 @@ public:
 			a = a_;
 			b = b_;
 			c = c_;
+			material = NULL;
+			shading = FLAT;
 		}
 
 		Triangle(unsigned int a_, unsigned int b_, unsigned int c_, ofVec2f uv1, ofVec2f uv2, ofVec2f uv3) {
@@ -61,12 +64,17 @@ public:
 			shading = shade;
 			hasTriangles = false;
 			hasUvs = hasUvs_;
+			isUploaded = false;
 			primitive.setUseVbo(true);
 		}
 
 		void draw();
+		//uploads the triangles to the part's own vbo, has to be called from the GL thread
+		void upload();
 
 		of3dPrimitive primitive;
+		ofVbo vbo;
+		bool isUploaded;
 		Material* material;
 		Shading shading;
 		std::vector<Triangle> polys;
@@ -82,12 +90,17 @@ public:
 	void pushShading(Shading shading);
 
 	void addVertex(ofVec3f pos, ofVec3f norm=ofVec3f());
+	//takes over the contents of both arrays (they are swapped), missing normals are zero
+	void setVertices(Vec3Array& positions, Vec3Array& normals);
 	void addTriangle(Triangle triangle);
+	void reserveTriangles(unsigned int count);
 	void addMesh(ofMesh& mesh);
 
-	ofVec3f& getVertex(unsigned int index);
-	ofVec3f& getNormal(unsigned int index);
+	ofVec3f getVertex(unsigned int index);
+	ofVec3f getNormal(unsigned int index);
+	unsigned int getNumVertices();
 	Triangle& getTriangle(unsigned int index);
+	unsigned int getNumTriangles();
 
 	void exportUVs(int w=1024, int h=1024, unsigned int layer=0, string path="");
 
@@ -95,18 +108,31 @@ public:
 
 	void clear();
 
+	//groups the triangles into parts and assembles their meshes, only touches cpu memory and can run on any thread
 	void build();
+	bool isBuilt();
+	//builds the meshes on numThreads threads of the shared pool (0 = all cores), the largest first so the last one to
+	//start is a small one. build is called for every mesh instead of Mesh::build if it is set
+	static void buildAll(const std::vector<Mesh*>& meshes, unsigned int numThreads=0, std::function<void(Mesh*)> build=std::function<void(Mesh*)>());
+	//uploads all parts to the graphics card, otherwise they are uploaded when first drawn
+	void upload();
 
 	void customDraw();
 	void drawNormals(float length=1);
 
+	//mesh data, part meshes and their gpu buffers
+	void addMemoryUsage(MemoryReport& report);
+
 	string meshName;
 
 	bool isTwoSided;
 	bool isTransparent;
 
+	//of the vertices in object space, boundsMin is larger than boundsMax while there are none
 	ofVec3f boundsMin;
 	ofVec3f boundsMax;
+	//bounds of the vertices transformed by the global transform matrix, false if there are no vertices
+	bool getGlobalBounds(ofVec3f& min, ofVec3f& max);
 
 private:
 	friend class Scene;
@@ -115,8 +141,9 @@ private:
 		
 	Material* curMaterial;
 	Shading curShading;
-	std::vector<ofVec3f> vertices;
-	std::vector<ofVec3f> normals;
+	bool built;
+	Vec3Array vertices;
+	Vec3Array normals;
 	std::vector<Triangle> triangles;
 	std::vector<Part> parts;
 	std::vector<Material*> materials;
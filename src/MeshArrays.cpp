@@ -0,0 +1,180 @@
+#include "MeshArrays.h"
+
+namespace ofx {
+namespace blender {
+
+//polygons per chunk of triangulate
+static const unsigned int TRIANGULATE_CHUNK = 4096;
+
+//twice the signed area of the triangle abc, positive if it turns counter clockwise
+static float getTurn(const ofVec2f& a, const ofVec2f& b, const ofVec2f& c) {
+	return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+void MeshArrays::decodeVertices(const ArrayView<float>& coords, const ArrayView<short>& normalValues) {
+	positions.clear();
+	normals.clear();
+	if(coords.getComponents() < 3)
+		return;
+
+	if(coords.getComponents() == 3) {
+		std::vector<float> packed(coords.size() * 3);
+		coords.copyTo(packed.data());
+		positions.setInterleaved(packed.data(), coords.size());
+	} else {
+		positions.resize(coords.size());
+		for(size_t i=0; i<coords.size(); i++)
+			positions.set(i, ofVec3f(coords.get(i, 0), coords.get(i, 1), coords.get(i, 2)));
+	}
+
+	if(normalValues.getComponents() != 3 || normalValues.size() < positions.size())
+		return;
+	std::vector<short> packed(normalValues.size() * 3);
+	normalValues.copyTo(packed.data());
+	normals.setNormalized(packed.data(), positions.size());
+}
+
+void MeshArrays::decodeLoops(const ArrayView<int>& vertices) {
+	loopVertices.resize(vertices.size() * vertices.getComponents());
+	if(!loopVertices.empty())
+		vertices.copyTo(loopVertices.data());
+}
+
+void MeshArrays::decodePolygons(const ArrayView<int>& loopStarts, const ArrayView<int>& numLoops, const ArrayView<short>& materials, const ArrayView<char>& flags) {
+	size_t count = std::min(loopStarts.size(), numLoops.size());
+	polygons.resize(count);
+	for(size_t i=0; i<count; i++) {
+		Polygon& polygon = polygons[i];
+		polygon.loopStart = loopStarts.get(i);
+		polygon.numLoops = numLoops.get(i);
+		polygon.material = i < materials.size() ? materials.get(i) : 0;
+		polygon.flag = i < flags.size() ? flags.get(i) : 0;
+	}
+}
+
+void MeshArrays::triangulate(const Vec3Array& positions, unsigned int numThreads) {
+	//offsets of the triangles of every polygon, broken polygons get none
+	polygonTriangles.assign(polygons.size() + 1, 0);
+	unsigned int numDropped = 0;
+	for(size_t i=0; i<polygons.size(); i++) {
+		const Polygon& polygon = polygons[i];
+		bool valid = polygon.numLoops >= 3 && polygon.loopStart >= 0 && size_t(polygon.loopStart) + polygon.numLoops <= loopVertices.size();
+		for(int j=0; valid && j<polygon.numLoops; j++)
+			valid = (unsigned int)loopVertices[polygon.loopStart + j] < positions.size();
+		//polygons with less than 3 corners are reported by the parser
+		if(!valid && polygon.numLoops >= 3)
+			numDropped++;
+		polygonTriangles[i + 1] = polygonTriangles[i] + (valid ? polygon.numLoops - 2 : 0);
+	}
+	if(numDropped > 0)
+		ofLogWarning(OFX_BLENDER) << "can't convert " << numDropped << " polygons with loops or vertices outside of the mesh";
+	triangleLoops.resize(polygonTriangles.back() * 3);
+
+	//every polygon writes to its own range, the chunks don't need any locking
+	unsigned int numChunks = (polygons.size() + TRIANGULATE_CHUNK - 1) / TRIANGULATE_CHUNK;
+	parallelFor(numChunks, [&](unsigned int chunk) {
+		std::vector<ofVec2f> points;
+		std::vector<int> remaining;
+		size_t end = std::min(polygons.size(), size_t(chunk + 1) * TRIANGULATE_CHUNK);
+		for(size_t i=size_t(chunk) * TRIANGULATE_CHUNK; i<end; i++) {
+			if(polygonTriangles[i + 1] > polygonTriangles[i])
+				triangulatePolygon(polygons[i], positions, &triangleLoops[polygonTriangles[i] * 3], points, remaining);
+		}
+	}, numThreads);
+}
+
+void MeshArrays::triangulatePolygon(const Polygon& polygon, const Vec3Array& positions, int* out, std::vector<ofVec2f>& points, std::vector<int>& remaining) {
+	int first = polygon.loopStart;
+	int n = polygon.numLoops;
+	auto getPosition = [&](int corner) -> ofVec3f {
+		return positions.get(loopVertices[first + corner]);
+	};
+	auto addTriangle = [&](int a, int b, int c) {
+		*out++ = first + a;
+		*out++ = first + b;
+		*out++ = first + c;
+	};
+
+	if(n == 3) {
+		addTriangle(0, 1, 2);
+		return;
+	}
+	if(n == 4) {
+		//split the same way as before n-gons were supported
+		ofVec3f e0 = getPosition(0) - getPosition(1);
+		ofVec3f e1 = getPosition(2) - getPosition(3);
+		if(e0.lengthSquared() < e1.lengthSquared()) {
+			addTriangle(0, 1, 2);
+			addTriangle(2, 3, 0);
+		} else {
+			addTriangle(0, 1, 3);
+			addTriangle(3, 1, 2);
+		}
+		return;
+	}
+
+	//project onto the plane of the largest component of the newell normal, its sign is the winding in that plane
+	ofVec3f normal;
+	for(int i=0; i<n; i++) {
+		ofVec3f cur = getPosition(i);
+		ofVec3f next = getPosition((i + 1) % n);
+		normal.x += (cur.y - next.y) * (cur.z + next.z);
+		normal.y += (cur.z - next.z) * (cur.x + next.x);
+		normal.z += (cur.x - next.x) * (cur.y + next.y);
+	}
+	int axis = 2;
+	if(fabs(normal.x) >= fabs(normal.y) && fabs(normal.x) >= fabs(normal.z))
+		axis = 0;
+	else if(fabs(normal.y) >= fabs(normal.z))
+		axis = 1;
+	float winding = normal[axis] < 0 ? -1 : 1;
+	points.resize(n);
+	for(int i=0; i<n; i++) {
+		ofVec3f pos = getPosition(i);
+		points[i].set(pos[(axis + 1) % 3], pos[(axis + 2) % 3]);
+	}
+
+	//convex polygons are a fan around the first corner
+	bool convex = true;
+	for(int i=0; i<n && convex; i++)
+		convex = getTurn(points[i], points[(i + 1) % n], points[(i + 2) % n]) * winding >= 0;
+	if(convex) {
+		for(int i=1; i<n-1; i++)
+			addTriangle(0, i, i + 1);
+		return;
+	}
+
+	//ear clipping: cut off corners that turn with the polygon and contain no other corner
+	remaining.resize(n);
+	for(int i=0; i<n; i++)
+		remaining[i] = i;
+	while(remaining.size() > 3) {
+		size_t m = remaining.size();
+		size_t ear = m;
+		for(size_t k=0; k<m && ear == m; k++) {
+			int a = remaining[(k + m - 1) % m];
+			int b = remaining[k];
+			int c = remaining[(k + 1) % m];
+			if(getTurn(points[a], points[b], points[c]) * winding <= 0)
+				continue;
+			bool isEmpty = true;
+			for(size_t j=0; j<m && isEmpty; j++) {
+				int p = remaining[j];
+				if(p == a || p == b || p == c)
+					continue;
+				isEmpty = getTurn(points[a], points[b], points[p]) * winding < 0 || getTurn(points[b], points[c], points[p]) * winding < 0 || getTurn(points[c], points[a], points[p]) * winding < 0;
+			}
+			if(isEmpty)
+				ear = k;
+		}
+		//degenerate polygons may have no ear left, a corner is cut off anyway
+		if(ear == m)
+			ear = 0;
+		addTriangle(remaining[(ear + m - 1) % m], remaining[ear], remaining[(ear + 1) % m]);
+		remaining.erase(remaining.begin() + ear);
+	}
+	addTriangle(remaining[0], remaining[1], remaining[2]);
+}
+
+}
+}
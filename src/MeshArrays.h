@@ -0,0 +1,48 @@
+#ifndef BLENDER_MESHARRAYS_H
+#define BLENDER_MESHARRAYS_H
+
+#include "Utils.h"
+#include "ArrayView.h"
+#include "Vec3Array.h"
+
+namespace ofx {
+namespace blender {
+
+//flat copies of the MVert, MLoop and MPoly blocks of a mesh, each block is decoded in a single pass instead of
+//reading the fields of every element through a DNAStructureReader
+class MeshArrays {
+public:
+	struct Polygon {
+		int loopStart;
+		int numLoops;
+		short material;
+		char flag;
+	};
+
+	//the normals are normalized, as Blender stores them as shorts scaled to 32767. they stay empty without a normals view
+	void decodeVertices(const ArrayView<float>& coords, const ArrayView<short>& normals);
+	void decodeLoops(const ArrayView<int>& vertices);
+	void decodePolygons(const ArrayView<int>& loopStarts, const ArrayView<int>& numLoops, const ArrayView<short>& materials, const ArrayView<char>& flags);
+
+	//splits the polygons into triangles, quads along their shorter edge pair, convex polygons as a fan and concave ones by
+	//ear clipping. the polygons are processed in chunks spread over numThreads threads (0 = all cores). polygons that
+	//point outside of the loops or vertices get no triangles, a warning tells how many
+	void triangulate(const Vec3Array& positions, unsigned int numThreads=0);
+
+	Vec3Array positions;
+	Vec3Array normals;
+	std::vector<int> loopVertices;
+	std::vector<Polygon> polygons;
+	//result of triangulate: the triangles of polygon i are [polygonTriangles[i], polygonTriangles[i + 1]), their corners
+	//are loop indices (3 per triangle), so the uvs of the loops can be looked up as well
+	std::vector<unsigned int> polygonTriangles;
+	std::vector<int> triangleLoops;
+
+private:
+	void triangulatePolygon(const Polygon& polygon, const Vec3Array& positions, int* out, std::vector<ofVec2f>& points, std::vector<int>& remaining);
+};
+
+}
+}
+
+#endif // BLENDER_MESHARRAYS_H
@@ -4,7 +4,98 @@ namespace ofx {
 namespace blender {
 
 Parser::HandlerList Parser::handlers;
+Parser::ObjectHandler* Parser::objectHandler = NULL;
 bool Parser::isInit = false;
 
+FieldHandle Parser::objectType("Object", "type");
+FieldHandle Parser::objectData("Object", "data");
+FieldHandle Parser::bezTripleVec("BezTriple", "vec");
+FieldHandle Parser::bezTripleIpo("BezTriple", "ipo");
+FieldHandle Parser::mvertCo("MVert", "co");
+FieldHandle Parser::mvertNo("MVert", "no");
+FieldHandle Parser::mpolyTotLoop("MPoly", "totloop");
+FieldHandle Parser::mpolyFlag("MPoly", "flag");
+FieldHandle Parser::mpolyMatNr("MPoly", "mat_nr");
+FieldHandle Parser::mpolyLoopStart("MPoly", "loopstart");
+FieldHandle Parser::mloopV("MLoop", "v");
+FieldHandle Parser::mloopUVUv("MLoopUV", "uv");
+StructHandle Parser::mloopUVType("MLoopUV");
+StructHandle Parser::trackToType("bTrackToConstraint");
+
+FieldHandle Parser::idName("ID", "name");
+FieldHandle Parser::sceneId("Scene", "id");
+FieldHandle Parser::sceneR("Scene", "r");
+FieldHandle Parser::sceneBase("Scene", "base");
+FieldHandle Parser::sceneCamera("Scene", "camera");
+FieldHandle Parser::sceneWorld("Scene", "world");
+FieldHandle Parser::sceneMarkers("Scene", "markers");
+FieldHandle Parser::renderFrsSec("RenderData", "frs_sec");
+FieldHandle Parser::renderEfra("RenderData", "efra");
+FieldHandle Parser::baseObject("Base", "object");
+FieldHandle Parser::baseNext("Base", "next");
+FieldHandle Parser::worldHorR("World", "horr");
+FieldHandle Parser::worldHorG("World", "horg");
+FieldHandle Parser::worldHorB("World", "horb");
+FieldHandle Parser::markerFrame("TimeMarker", "frame");
+FieldHandle Parser::markerName("TimeMarker", "name");
+FieldHandle Parser::animDataAction("AnimData", "action");
+FieldHandle Parser::actionCurves("bAction", "curves");
+FieldHandle Parser::fcurveTotVert("FCurve", "totvert");
+FieldHandle Parser::fcurveBezt("FCurve", "bezt");
+FieldHandle Parser::fcurveRnaPath("FCurve", "rna_path");
+FieldHandle Parser::fcurveArrayIndex("FCurve", "array_index");
+FieldHandle Parser::objectId("Object", "id");
+FieldHandle Parser::objectLay("Object", "lay");
+FieldHandle Parser::objectObmat("Object", "obmat");
+FieldHandle Parser::objectParent("Object", "parent");
+FieldHandle Parser::objectConstraints("Object", "constraints");
+FieldHandle Parser::constraintName("bConstraint", "name");
+FieldHandle Parser::constraintData("bConstraint", "data");
+FieldHandle Parser::trackToTar("bTrackToConstraint", "tar");
+FieldHandle Parser::meshId("Mesh", "id");
+FieldHandle Parser::meshMpoly("Mesh", "mpoly");
+FieldHandle Parser::meshMloop("Mesh", "mloop");
+FieldHandle Parser::meshMvert("Mesh", "mvert");
+FieldHandle Parser::meshMloopuv("Mesh", "mloopuv");
+FieldHandle Parser::meshLdata("Mesh", "ldata");
+FieldHandle Parser::meshTotVert("Mesh", "totvert");
+FieldHandle Parser::meshTotPoly("Mesh", "totpoly");
+FieldHandle Parser::meshMat("Mesh", "mat");
+FieldHandle Parser::customDataTotLayer("CustomData", "totlayer");
+FieldHandle Parser::customDataLayers("CustomData", "layers");
+FieldHandle Parser::customDataLayerData("CustomDataLayer", "data");
+FieldHandle Parser::customDataLayerName("CustomDataLayer", "name");
+FieldHandle Parser::materialId("Material", "id");
+FieldHandle Parser::materialSpec("Material", "spec");
+FieldHandle Parser::materialR("Material", "r");
+FieldHandle Parser::materialG("Material", "g");
+FieldHandle Parser::materialB("Material", "b");
+FieldHandle Parser::materialSpecR("Material", "specr");
+FieldHandle Parser::materialSpecG("Material", "specg");
+FieldHandle Parser::materialSpecB("Material", "specb");
+FieldHandle Parser::materialMtex("Material", "mtex");
+FieldHandle Parser::mtexTex("MTex", "tex");
+FieldHandle Parser::mtexUvName("MTex", "uvname");
+FieldHandle Parser::texId("Tex", "id");
+FieldHandle Parser::texType("Tex", "type");
+FieldHandle Parser::texIma("Tex", "ima");
+FieldHandle Parser::imageName("Image", "name");
+FieldHandle Parser::imagePackedFile("Image", "packedfile");
+FieldHandle Parser::packedFileSize("PackedFile", "size");
+FieldHandle Parser::packedFileData("PackedFile", "data");
+FieldHandle Parser::cameraLens("Camera", "lens");
+FieldHandle Parser::cameraClipSta("Camera", "clipsta");
+FieldHandle Parser::cameraClipEnd("Camera", "clipend");
+FieldHandle Parser::lampType("Lamp", "type");
+FieldHandle Parser::lampEnergy("Lamp", "energy");
+FieldHandle Parser::lampDist("Lamp", "dist");
+FieldHandle Parser::lampAtt1("Lamp", "att1");
+FieldHandle Parser::lampAtt2("Lamp", "att2");
+FieldHandle Parser::lampSpotSize("Lamp", "spotsize");
+FieldHandle Parser::lampSpotBlend("Lamp", "spotblend");
+FieldHandle Parser::lampR("Lamp", "r");
+FieldHandle Parser::lampG("Lamp", "g");
+FieldHandle Parser::lampB("Lamp", "b");
+
 }
 }
@@ -1,13 +1,17 @@
 #ifndef FILEPARSERS_H
 #define FILEPARSERS_H
 
-//all of the code is in the header file. this file should only be included once and that is by the file.cpp
+//the parsers are in the header file, the static handlers and field handles they use are defined in Parser.cpp.
+//this file should only be included by File.cpp and Parser.cpp
 
 #include "Scene.h"
 #include "Object.h"
 #include "File.h"
 #include "Mesh.h"
 #include "Material.h"
+#include "GeneratedLayout.h"
+#include "MeshArrays.h"
+#include <set>
 
 enum BLENDER_TYPES {
     BL_EMPTY_ID = 0,
@@ -41,9 +45,13 @@ namespace blender {
 class DNAStructureReader {
 public:
 
-	DNAStructureReader(File::Block* b) {
+	DNAStructureReader(File::Block* b, unsigned int offsetInBlock=0) {
 		file = b->file;
 		block = b;
+		firstBlock = 0;
+		//pointers into a block point to one of its structures
+		if(offsetInBlock != 0 && block->structure->type->size != 0)
+			firstBlock = offsetInBlock / block->structure->type->size;
 		reset();
 	};
 
@@ -52,7 +60,7 @@ public:
 	}
 
 	void reset() {
-		curBlock = 0;
+		curBlock = firstBlock;
 		nextBlock();
 	}
 
@@ -62,7 +70,7 @@ public:
 
 	//multiple structures can be integrated into one block, move ahead in the file
 	void nextBlock() {
-		setStructure(block->structure, block->offset + streampos(structure->type->size * curBlock));
+		setStructure(block->structure, block->offset + streampos(block->structure->type->size * curBlock));
 		curBlock++;
 	}
 
@@ -84,6 +92,12 @@ public:
 		return *this;
 	}
 
+	//true if the current structure is of the given type
+	bool isType(const StructHandle& type) {
+		int index = file->catalog.getStructureIndex(type);
+		return index != -1 && structure == &file->catalog.structures[index];
+	}
+
 	DNAStructureReader& setStructure(DNAStructure* s, streamoff offset) {
 		structure = s;
 		currentOffset = offset;
@@ -91,33 +105,53 @@ public:
 	}
 
 	//set another structure according to the provided field name
-	DNAStructureReader& setStructure(string structureName) {
-		if(!structure->hasField(structureName)) {
-			ofLogWarning(OFX_BLENDER) << "Property \"" << structureName << "\" not found in " << structure->type->name;
+	DNAStructureReader& setStructure(const FieldHandle& fieldName) {
+		DNAField* field = getField(fieldName);
+		if(!field)
 			return *this;
-		}
-		DNAField& field = structure->getField(structureName);
-		DNAStructure* s = file->catalog.getStructure(field.type->name);
-		if(!s)
+		if(field->structureIndex == -1) {
+			ofLogWarning(OFX_BLENDER) << "Structure " << field->type->name << " not found in DNA Catalog";
 			return *this;
-		setStructure(s, currentOffset + std::streampos(field.offset));
+		}
+		setStructure(&file->catalog.structures[field->structureIndex], currentOffset + std::streampos(field->offset));
 		return *this;
 	}
 
-	DNAField* setField(string fieldName) {
-		if(!structure->hasField(fieldName)) {
+	DNAField* getField(const FieldHandle& fieldName) {
+		DNAField* field = file->catalog.getField(fieldName, structure);
+		if(!field)
 			ofLogWarning(OFX_BLENDER) << "Property \"" << fieldName << "\" not found in " << structure->type->name;
-			return NULL;
-		}
-		DNAField& field = structure->getField(fieldName);
-		file->seek(currentOffset + std::streampos(field.offset));
-		return &field;
+		return field;
+	}
+
+	//typed view on the structures of the block starting at the current one, invalid if the generated layout
+	//does not match the file or the file is not in memory
+	template<typename View>
+	View getView() {
+		if(View::layoutIndex >= file->layoutStructures.size() || !file->buffer.isOpen())
+			return View();
+		int index = file->layoutStructures[View::layoutIndex];
+		if(index == -1 || structure != &file->catalog.structures[index] || curBlock == 0 || curBlock > block->count)
+			return View();
+		return View(file->buffer.at(currentOffset, View::structSize * (block->count - curBlock + 1)));
+	}
+
+	//absolute position of a field of the current structure within the file
+	streamoff getOffset(DNAField* field) {
+		return currentOffset + streamoff(field->offset);
+	}
+
+	DNAField* setField(const FieldHandle& fieldName) {
+		DNAField* field = getField(fieldName);
+		if(field)
+			file->seek(getOffset(field));
+		return field;
 	}
 
 	template<typename Type>
-	std::vector<Type> readVector(string fieldName) {
+	std::vector<Type> readVector(const FieldHandle& fieldName) {
 		std::vector<Type> ret;
-		DNAField* field = setField(fieldName);
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return ret;
 		}
@@ -131,17 +165,17 @@ public:
 		}
 
 		if(field->arraySizes[0] != 0) {
-			for(unsigned int i=0; i < field->arraySizes[0]; i++) {
-				ret.push_back(file->read<Type>());
-			}
+			ret.resize(field->arraySizes[0]);
+			if(!file->readAt<Type>(getOffset(field), &ret[0], ret.size()))
+				ret.clear();
 		}
 
 		return ret;
 	}
 
-	std::vector<unsigned long> readAddressArray(string fieldName) {
+	std::vector<unsigned long> readAddressArray(const FieldHandle& fieldName) {
 		std::vector<unsigned long> ret;
-		DNAField* field = setField(fieldName);
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return ret;
 		}
@@ -153,40 +187,44 @@ public:
 			return ret;
 		}
 
+		streamoff offset = getOffset(field);
 		if(field->arraySizes[0] > 0) {
 			for(unsigned int i=0; i < field->arraySizes[0]; i++) {
-				unsigned long ptr = file->readPointer();
+				unsigned long ptr = file->readPointerAt(offset);
 				if(ptr != 0)
 					ret.push_back(ptr);
+				offset += file->pointerSize;
 			}
 		} else {
 			while(true) {
-				unsigned long addr = file->readPointer();
+				unsigned long addr = file->readPointerAt(offset);
 				if(addr == 0)
 					break;
 				else
 					ret.push_back(addr);
+				offset += file->pointerSize;
 			}
 		}
 		return ret;
 	}
 
-	std::vector<DNAStructureReader> readStructureArray(string fieldName) {
+	std::vector<DNAStructureReader> readStructureArray(const FieldHandle& fieldName) {
 		std::vector<unsigned long> addresses = readAddressArray(fieldName);
 		std::vector<DNAStructureReader> ret;
 		for(unsigned long& address: addresses) {
-			File::Block* block = file->getBlockByAddress(address);
+			unsigned int offset;
+			File::Block* block = file->getBlockByAddress(address, offset);
 			if(block != NULL) {
-				ret.push_back(DNAStructureReader(block));
+				ret.push_back(DNAStructureReader(block, offset));
 			}
 		}
 		return ret;
 	};
 
 	template<typename Type>
-	std::vector<std::vector<Type> > readMultArray(string fieldName) {
+	std::vector<std::vector<Type> > readMultArray(const FieldHandle& fieldName) {
 		std::vector<std::vector<Type> > ret;
-		DNAField* field = setField(fieldName);
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return ret;
 		}
@@ -198,12 +236,14 @@ public:
 		if(field->arrayDimensions <= 1)
 			ofLogWarning(OFX_BLENDER) << "Property \"" << fieldName << "\" has only one array dimension, use readArray";
 
-		for(unsigned int i=0; i < field->arraySizes[0]; i++) {
-			std::vector<Type> temp;
-			for(unsigned int j=0; j<field->arraySizes[1]; j++) {
-				temp.push_back(file->read<Type>());
-			}
-			ret.push_back(temp);
+		unsigned int rows = field->arraySizes[0];
+		unsigned int cols = field->arrayDimensions > 1 ? field->arraySizes[1] : 1;
+		std::vector<Type> values(rows * cols);
+		if(values.empty() || !file->readAt<Type>(getOffset(field), &values[0], values.size()))
+			return ret;
+
+		for(unsigned int i=0; i < rows; i++) {
+			ret.push_back(std::vector<Type>(values.begin() + i * cols, values.begin() + (i + 1) * cols));
 		}
 
 
@@ -211,7 +251,7 @@ public:
 	}
 
 	template<typename Type>
-	Type read(string fieldName) {
+	Type read(const FieldHandle& fieldName) {
 
 		//check for specials functions
 		if(std::is_same<Type, std::string>::value) {
@@ -221,7 +261,7 @@ public:
 
 		bool isPointer = std::is_pointer<Type>::value;
 
-		DNAField* field = setField(fieldName);
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return Type();
 		}
@@ -232,11 +272,11 @@ public:
 		}
 
 		//read the file contents
-		return file->read<Type>();
+		return file->readAt<Type>(getOffset(field));
 	}
 
-	string readString(string fieldName) {
-		DNAField* field = setField(fieldName);
+	string readString(const FieldHandle& fieldName) {
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return "undefined";
 		}
@@ -249,12 +289,8 @@ public:
 		}
 
 		if(field->isArray || field->isPointer) {
-			string ret = file->readString();
 			//strings are usually object names or paths, objects names have the object type prepending, check and remove
-			if(ret.size() >= block->code.size() && block->code == ret.substr(0, block->code.size())) {
-				ret = ret.substr(block->code.size());
-			}
-			return ret;
+			return file->readNameAt(getOffset(field), block->code);
 		}
 		ofLogWarning(OFX_BLENDER) << "Could not read string, not a char* " << fieldName;
 		return "undefined";
@@ -262,7 +298,7 @@ public:
 
 //get a vec2
 	template<typename Type>
-	ofVec2f readVec2(string fieldName) {
+	ofVec2f readVec2(const FieldHandle& fieldName) {
 		ofVec2f ret;
 		std::vector<Type> vals = readVector<Type>(fieldName);
 		if(vals.size() >= 2) {
@@ -270,13 +306,13 @@ public:
 		}
 		return ret;
 	}
-	ofVec2f readVec2f(string fieldName) {
+	ofVec2f readVec2f(const FieldHandle& fieldName) {
 		return readVec2<float>(fieldName);
 	}
 
 //get a vec3
 	template<typename Type>
-	ofVec3f readVec3(string fieldName) {
+	ofVec3f readVec3(const FieldHandle& fieldName) {
 		ofVec3f ret;
 		std::vector<Type> vals = readVector<Type>(fieldName);
 		if(vals.size() >= 3) {
@@ -284,14 +320,14 @@ public:
 		}
 		return ret;
 	}
-	ofVec3f readVec3f(string fieldName) {
+	ofVec3f readVec3f(const FieldHandle& fieldName) {
 		return readVec3<float>(fieldName);
 	}
 
 	template<typename Type>
-	std::vector<ofVec3f> readVec3Array(string fieldName, unsigned int len=0) {
+	std::vector<ofVec3f> readVec3Array(const FieldHandle& fieldName, unsigned int len=0) {
 		std::vector<ofVec3f> ret;
-		DNAField* field = setField(fieldName);
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return ret;
 		}
@@ -301,45 +337,87 @@ public:
 				len = field->arraySizes[0];
 		}
 
+		std::vector<Type> values(len * 3);
+		if(values.empty() || !file->readAt<Type>(getOffset(field), &values[0], values.size()))
+			return ret;
+
+		ret.reserve(len);
 		for(unsigned int i=0; i<len; i++) {
-			Type x = file->read<Type>();
-			Type y = file->read<Type>();
-			Type z = file->read<Type>();
-			ret.push_back(ofVec3f(x, y, z));
+			ret.push_back(ofVec3f(values[i*3], values[i*3+1], values[i*3+2]));
 		}
 
 		return ret;
 	}
-	std::vector<ofVec3f> readVec3fArray(string fieldName, unsigned int len=0) {
+	std::vector<ofVec3f> readVec3fArray(const FieldHandle& fieldName, unsigned int len=0) {
 		return readVec3Array<float>(fieldName, len);
 	}
 
+	//view on a field across the structures of the block, starting at the current one. count 0 means up to the end of the block
+	//e.g. readView<float>("co") on an MVert block gives the coordinates of all vertices with 3 components each
+	template<typename Type>
+	ArrayView<Type> readView(const FieldHandle& fieldName, unsigned int count=0) {
+		DNAField* field = getField(fieldName);
+		if(!field || curBlock == 0 || curBlock > block->count)
+			return ArrayView<Type>();
+
+		unsigned int remaining = block->count - (curBlock - 1);
+		if(count > remaining)
+			ofLogWarning(OFX_BLENDER) << "DNAStructureReader::readView only " << remaining << " of " << count << " \"" << fieldName << "\" in block";
+		if(count == 0 || count > remaining)
+			count = remaining;
+		return file->readView<Type>(getOffset(field), count, structure->type->size, getFieldSize(field) / sizeof(Type));
+	}
+
+	//view on the values of an array field of the current structure
+	template<typename Type>
+	ArrayView<Type> readArrayView(const FieldHandle& fieldName) {
+		DNAField* field = getField(fieldName);
+		if(!field)
+			return ArrayView<Type>();
+		return file->readView<Type>(getOffset(field), getFieldSize(field) / sizeof(Type), sizeof(Type), 1);
+	}
+
+	//size of a field in bytes including all array elements
+	unsigned int getFieldSize(DNAField* field) {
+		unsigned int size = field->isPointer ? file->pointerSize : field->type->size;
+		for(unsigned int arraySize: field->arraySizes) {
+			if(arraySize > 0)
+				size *= arraySize;
+		}
+		return size;
+	}
+
 	//get an array
 	template<typename Type>
-	Type* readArray(string fieldName, unsigned int amount) {
-		DNAField* field = setField(fieldName);
+	Type* readArray(const FieldHandle& fieldName, unsigned int amount) {
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return new Type[0];
 		}
-		return file->readMany<Type>(amount);
+		Type* ret = new Type[amount];
+		if(!file->readAt<Type>(getOffset(field), ret, amount))
+			std::fill(ret, ret + amount, Type());
+		return ret;
 	}
 
 //get a pointer address
-	unsigned long readAddress(string fieldName) {
-		DNAField* field = setField(fieldName);
+	unsigned long readAddress(const FieldHandle& fieldName) {
+		DNAField* field = getField(fieldName);
 		if(!field) {
 			return 0;
 		}
-		return file->readPointer();
+		return file->readPointerAt(getOffset(field));
 	}
 
-	char* readChar(string fieldName, unsigned int length) {
-		setField(fieldName);
-		return file->readChar(length);
+	std::vector<char> readChar(const FieldHandle& fieldName, unsigned int length) {
+		DNAField* field = getField(fieldName);
+		if(!field)
+			return file->readCharAt(-1, length);
+		return file->readCharAt(getOffset(field), length);
 	}
 
 //a linked list is basically an array of different structures
-	std::vector<DNAStructureReader> readLinkedList(string fieldName) {
+	std::vector<DNAStructureReader> readLinkedList(const FieldHandle& fieldName) {
 		std::vector<DNAStructureReader> ret;
 		unsigned long address = readAddress(fieldName);
 		if(address == 0)
@@ -352,16 +430,17 @@ public:
 		}*/
 
 		//Get the first structure
-		ret.push_back(DNAStructureReader(block->file->getBlockByAddress(address)));
-		while(ret.back().readAddress("next")) {
+		unsigned int offset = 0;
+		ret.push_back(DNAStructureReader(file->getBlockByAddress(address, offset), offset));
+		while((address = ret.back().readAddress("next"))) {
 			//and the next one
-			ret.push_back(DNAStructureReader(block->file->getBlockByAddress(ret.back().readAddress("next"))));
+			ret.push_back(DNAStructureReader(file->getBlockByAddress(address, offset), offset));
 		}
 
 		return ret;
 	}
 
-	std::vector<DNAStructureReader> readLinkAsList(string fieldName) {
+	std::vector<DNAStructureReader> readLinkAsList(const FieldHandle& fieldName) {
 		//TODO: I don't really get how these Links work, doublecheck
 
 		std::vector<DNAStructureReader> ret;
@@ -395,21 +474,22 @@ public:
 	}
 
 	//get a reader for sturcture at address
-	DNAStructureReader readStructure(string fieldName) {
+	DNAStructureReader readStructure(const FieldHandle& fieldName) {
 		unsigned long address = readAddress(fieldName);
 		if(address == 0) {
 			ofLogWarning(OFX_BLENDER) << "DNAStructureReader::readStructure could not read structure \"" << fieldName << "\" in \"" << getType() << "\" returning self";
 			return *this;
 		}
-		File::Block* block = file->getBlockByAddress(address);
+		unsigned int offset;
+		File::Block* block = file->getBlockByAddress(address, offset);
 		if(block == NULL) {
 			ofLogWarning(OFX_BLENDER) << "DNAStructureReader::readStructure could not read structure \"" << fieldName << "\" in \"" << getType() << "\" returning self";
 			return *this;
 		}
-		return DNAStructureReader(block);
+		return DNAStructureReader(block, offset);
 	}
 	/*
-	DNAStructureReader readStructure(string fieldName, string fieldType) {
+	DNAStructureReader readStructure(const FieldHandle& fieldName, string fieldType) {
 		unsigned long address = readAddress(fieldName);
 		if(address == 0) {
 			ofLogWarning(OFX_BLENDER) << "DNAStructureReader::readStructure could not read structure \"" << fieldName << "\" in \"" << getType() << "\" returning self";
@@ -421,7 +501,7 @@ public:
 	*/
 
 	bool hasNext() {
-		if(!structure->hasField("id"))
+		if(structure->getFieldIndex("id") == -1)
 			return false;
 		setStructure("id");
 		unsigned long addr = readAddress("next");
@@ -442,7 +522,7 @@ public:
 	}
 
 	bool hasPrev() {
-		if(!structure->hasField("id"))
+		if(structure->getFieldIndex("id") == -1)
 			return false;
 		setStructure("id");
 		unsigned long addr = readAddress("prev");
@@ -466,6 +546,10 @@ public:
 		return file->parseFileBlock(block);
 	}
 
+	File::Block* getBlock() {
+		return block;
+	}
+
 	File* file;
 
 private:
@@ -473,6 +557,7 @@ private:
 	File::Block* block;
 	streamoff currentOffset;
 	unsigned int curBlock;
+	unsigned int firstBlock;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////// PARSER
@@ -484,7 +569,8 @@ public:
 	public:
 		virtual void* call(DNAStructureReader&) = 0;
 		virtual void* call(DNAStructureReader&, void*) = 0;
-		virtual void* create() {
+		//parsed types are created in the arena of the file
+		virtual void* create(File*) {
 			return NULL;
 		}
 	};
@@ -497,7 +583,7 @@ public:
 			function = f;
 		}
 		void* call(DNAStructureReader& reader) {
-			return call(reader, new Type());
+			return call(reader, create(reader.file));
 		}
 		void* call(DNAStructureReader&  reader, void* obj) {
 			Type* t = static_cast<Type*>(obj);
@@ -505,8 +591,8 @@ public:
 			return obj;
 		}
 
-		void* create() {
-			return new Type();
+		void* create(File* file) {
+			return file->arena->create<Type>();
 		}
 
 		funcType function;
@@ -521,12 +607,34 @@ public:
 		}
 
 		void* call(DNAStructureReader& reader) {
+			//the data might have been parsed ahead on a worker thread, only the object itself is left
+			Object* prepared = reader.file->takePreparedObject(reader.getBlock()->address);
+			if(prepared) {
+				objFunction(reader, prepared);
+				return prepared;
+			}
+
 			Handler_* handler = getHandlerFor(getTypeId(reader));
 			//cout << getTypeId(reader) << endl;
 
 			if(!handler)
 				return NULL;
-			return call(reader, handler->create());
+			return call(reader, handler->create(reader.file));
+		}
+
+		//creates the object and parses only its data (e.g. the mesh), the object is parsed later with call
+		Object* callData(DNAStructureReader& reader) {
+			Handler_* handler = getHandlerFor(getTypeId(reader));
+			if(!handler)
+				return NULL;
+			File::Block* dataBlock = reader.file->getBlockByAddress(reader.readAddress(objectData));
+			if(!dataBlock)
+				return NULL;
+			Object* object = static_cast<Object*>(handler->create(reader.file));
+			Profiler::BlockScope scope(reader.file->profiler, dataBlock->structure->type->name);
+			DNAStructureReader dataReader(dataBlock);
+			handler->call(dataReader, object);
+			return object;
 		}
 
 		void* call(DNAStructureReader&  reader, void* obj) {
@@ -537,15 +645,28 @@ public:
 			Object* t = static_cast<Object*>(obj);
 			//parse all object parameters first
 			objFunction(reader, t);
-			//and then load the right data block and call the object
-			File::Block* dataBlock = reader.file->getBlockByAddress(reader.readAddress("data"));
+			//cameras and lights set up ofCamera and ofLight, which is left to the GL thread while loading in the background
+			if(reader.file->deferObjectSetup && (t->type == CAMERA || t->type == LIGHT)) {
+				reader.file->deferSetup(reader.getBlock(), t);
+				return obj;
+			}
+			callData(reader, t);
+			return obj;
+		}
+
+		//loads the right data block of an object that is already created and calls the handler of its type with it
+		void callData(DNAStructureReader& reader, Object* object) {
+			Handler_* handler = getHandlerFor(getTypeId(reader));
+			if(!handler)
+				return;
+			File::Block* dataBlock = reader.file->getBlockByAddress(reader.readAddress(objectData));
 			if(dataBlock) {
+				Profiler::BlockScope scope(reader.file->profiler, dataBlock->structure->type->name);
 				DNAStructureReader dataReader(dataBlock);
-				handler->call(dataReader, t);
+				handler->call(dataReader, object);
 			} else {
-				ofLogWarning(OFX_BLENDER) << "ObjectHandler could not read datablock at pointer " << reader.readAddress("data");
+				ofLogWarning(OFX_BLENDER) << "ObjectHandler could not read datablock at pointer " << reader.readAddress(objectData);
 			}
-			return obj;
 		}
 
 		template<typename Type>
@@ -556,7 +677,7 @@ public:
 	private:
 
 		int getTypeId(DNAStructureReader& reader) {
-			return reader.read<short>("type");
+			return reader.read<short>(objectType);
 		}
 
 		Handler_* getHandlerFor(int type) {
@@ -575,9 +696,9 @@ public:
 		if(isInit)
 			return;
 
-		Parser::handlers[BL_SCENE] = new Handler<Scene>(Parser::parseScene);
-		Parser::handlers[BL_MATERIAL] = new Handler<Material>(Parser::parseMaterial);
-		Parser::handlers[BL_TEXTURE] = new Handler<Texture>(Parser::parseTexture);
+		addHandler(BL_SCENE, new Handler<Scene>(Parser::parseScene));
+		addHandler(BL_MATERIAL, new Handler<Material>(Parser::parseMaterial));
+		addHandler(BL_TEXTURE, new Handler<Texture>(Parser::parseTexture));
 
 		//Types based on objects like Mesh, Camera, Light are special and need to be registered with the ObjectHandler
 		ObjectHandler* objHandler = new ObjectHandler(Parser::parseObject);
@@ -585,24 +706,112 @@ public:
 		objHandler->addHandler<Camera>(BL_CAM_ID, Parser::parseCamera);
 		objHandler->addHandler<Light>(BL_LIGHT_ID, Parser::parseLight);
 		objHandler->addHandler<Object>(BL_EMPTY_ID, Parser::parseEmpty);
-		Parser::handlers[BL_OBJECT] = objHandler;
+		addHandler(BL_OBJECT, objHandler);
+		objectHandler = objHandler;
 
 		isInit = true;
 	}
 
+	static void addHandler(string structureName, Handler_* handler) {
+		handlers.push_back(std::make_pair(StructHandle(structureName), handler));
+	}
+
+	//parses the data of an object block without the object itself, see ObjectHandler::call
+	static Object* parseObjectData(File::Block* block) {
+		DNAStructureReader reader(block);
+		return objectHandler->callData(reader);
+	}
+
+	//parses the data of an object block into an object that was created without it, see File::deferSetup
+	static void parseObjectData(File::Block* block, Object* object) {
+		DNAStructureReader reader(block);
+		objectHandler->callData(reader, object);
+	}
+
+	//the blocks a scene needs that can be parsed independently: mesh objects, their materials and the textures of those
+	static void collectSceneBlocks(File::Block* sceneBlock, std::vector<File::Block*>& objects, std::vector<File::Block*>& materials, std::vector<File::Block*>& textures) {
+		DNAStructureReader reader(sceneBlock);
+		File* file = reader.file;
+		if(reader.readAddress(sceneBase) == 0)
+			return;
+
+		std::set<File::Block*> collected;
+		DNAStructureReader base = reader.readStructure(sceneBase);
+		while(true) {
+			File::Block* objectBlock = file->getBlockByAddress(base.readAddress(baseObject));
+			if(objectBlock && collected.insert(objectBlock).second && passesFilter(DNAStructureReader(objectBlock))) {
+				DNAStructureReader objReader(objectBlock);
+				unsigned long dataAddress = objReader.readAddress(objectData);
+				File::Block* dataBlock = dataAddress != 0 ? file->getBlockByAddress(dataAddress) : NULL;
+				if(objReader.read<short>(objectType) == BL_MESH_ID && dataBlock) {
+					objects.push_back(objectBlock);
+					if(file->filter.skipMeshData || file->filter.boundsOnly)
+						continue;
+
+					DNAStructureReader meshReader(dataBlock);
+					for(DNAStructureReader& matReader: meshReader.readLinkAsList(meshMat)) {
+						if(!collected.insert(matReader.getBlock()).second)
+							continue;
+						materials.push_back(matReader.getBlock());
+						if(file->filter.skipTextures)
+							continue;
+						for(DNAStructureReader& texReader: matReader.readStructureArray(materialMtex)) {
+							if(collected.insert(texReader.getBlock()).second)
+								textures.push_back(texReader.getBlock());
+						}
+					}
+				}
+			}
+
+			if(base.readAddress(baseNext) == 0)
+				break;
+			base = base.readStructure(baseNext);
+		}
+	}
+
+	//checks an object against File::filter, name and type are read from the object block without parsing it
+	static bool passesFilter(DNAStructureReader objReader) {
+		const LoadFilter& filter = objReader.file->filter;
+		if(objReader.getBlock() == NULL)
+			return false;
+		if(!filter.types.empty()) {
+			ObjectType type;
+			switch(objReader.read<short>(objectType)) {
+			case BL_EMPTY_ID: type = EMPTY; break;
+			case BL_MESH_ID: type = MESH; break;
+			case BL_TEXT_ID: type = TEXT; break;
+			case BL_LIGHT_ID: type = LIGHT; break;
+			case BL_CAM_ID: type = CAMERA; break;
+			default: return false;
+			}
+			if(!filter.matchesType(type))
+				return false;
+		}
+		return filter.matchesObject(objReader.file->readIdName(objReader.getBlock()));
+	}
+
+	//handlers are picked by the SDNA index of the block, the handled structures are resolved once per file
+	static Handler_* getHandler(File::Block* block) {
+		for(std::pair<StructHandle, Handler_*>& handler: handlers) {
+			if(block->file->catalog.getStructureIndex(handler.first) == (int)block->SDNAIndex)
+				return handler.second;
+		}
+		return NULL;
+	}
+
 	//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	static void parseScene(DNAStructureReader& reader, Scene* scene) {
-		reader.setStructure("id");
-		scene->name = reader.readString("name");
+		reader.setStructure(sceneId);
+		scene->name = reader.readString(idName);
 		reader.reset();
 
-		ofLogNotice(OFX_BLENDER) << "Loading Scene \"" << scene->name << "\"";
+		ofLogVerbose(OFX_BLENDER) << "Loading Scene \"" << scene->name << "\"";
 
 		//read render settings
-		reader.setStructure("r");
-		short fps = reader.read<short>("frs_sec");
+		reader.setStructure(sceneR);
+		short fps = reader.read<short>(renderFrsSec);
 		scene->timeline.setLoop(true);
-		double duration = 1.f/(float)fps * (float)reader.read<int>("efra");
+		double duration = 1.f/(float)fps * (float)reader.read<int>(renderEfra);
 		scene->timeline.setDuration(duration);
 		reader.reset();
 
@@ -610,16 +819,18 @@ public:
 		//cout << "LENGTH " << reader.readStructure("fps_info").getType() << endl;
 
 		//loop through all objects and add them to the scene
-		DNAStructureReader next = reader.readStructure("base");
+		DNAStructureReader next = reader.readStructure(sceneBase);
 		do {
 			//Parser::parseFileBlock(getBlockByType(BL_OBJECT, index))
-			DNAStructureReader objReader = next.readStructure("object");
-			Object* object = static_cast<Object*>(objReader.parse());
+			DNAStructureReader objReader = next.readStructure(baseObject);
+			Object* object = NULL;
+			if(passesFilter(objReader))
+				object = static_cast<Object*>(objReader.parse());
 			if(object != NULL) {
 				scene->addObject(object);
 
 				//set the scene layer to the object
-				int layer = objReader.read<int>("lay");
+				int layer = objReader.read<int>(objectLay);
 				if(layer >= 0) {
 					object->layer = &scene->layers[layer];
 				}
@@ -631,27 +842,27 @@ public:
 			}
 
 			//cout << next.readStructure("object").setStructure("id").readString("name") << endl;
-			if(next.readAddress("next") == 0) {
+			if(next.readAddress(baseNext) == 0) {
 				break;
 			}
-			next = next.readStructure("next");
+			next = next.readStructure(baseNext);
 		} while(true);
 
 		//set active camera
-		if(reader.readAddress("camera") != 0) {
-			scene->setActiveCamera(static_cast<Camera*>(reader.file->getObjectByAddress(reader.readAddress("camera"))));
+		if(reader.readAddress(sceneCamera) != 0 && passesFilter(reader.readStructure(sceneCamera))) {
+			scene->setActiveCamera(static_cast<Camera*>(reader.file->getObjectByAddress(reader.readAddress(sceneCamera))));
 		}
 
 		//WORLD INFOS
-		DNAStructureReader worldReader = reader.readStructure("world");
-		scene->bgColor = ofFloatColor(worldReader.read<float>("horr"), worldReader.read<float>("horg"), worldReader.read<float>("horb"));
+		DNAStructureReader worldReader = reader.readStructure(sceneWorld);
+		scene->bgColor = ofFloatColor(worldReader.read<float>(worldHorR), worldReader.read<float>(worldHorG), worldReader.read<float>(worldHorB));
 		//cout << "COLOR MODEL " << worldReader.read<short>("colormodel") << endl;
 		//cout << reader.readStructure("base").readStructure("object").setStructure("id").readString("name") << endl;
 
 
 		//MARKERS
-		for(DNAStructureReader& markerReader: reader.readLinkedList("markers")) {
-			scene->timeline.addMarker(1.f/(float)fps * (float)markerReader.read<int>("frame"), markerReader.readString("name"));
+		for(DNAStructureReader& markerReader: reader.readLinkedList(sceneMarkers)) {
+			scene->timeline.addMarker(1.f/(float)fps * (float)markerReader.read<int>(markerFrame), markerReader.readString(markerName));
 		}
 	}
 
@@ -664,15 +875,37 @@ public:
 
 	static std::vector<TempKeyFrame> parseKeyframes(DNAStructureReader curve) {
 		std::vector<TempKeyFrame> ret;
-		int numPoints = curve.read<int>("totvert");
-		DNAStructureReader bezier = curve.readStructure("bezt");
+		layout::FCurve fcurve = curve.getView<layout::FCurve>();
+		int numPoints = fcurve.isValid() ? fcurve.totvert() : curve.read<int>(fcurveTotVert);
+		DNAStructureReader bezier = curve.readStructure(fcurveBezt);
+		layout::BezTriple bezTriples = bezier.getView<layout::BezTriple>();
+		bool useView = bezTriples.isValid() && numPoints >= 0 && bezier.count() >= (unsigned int)numPoints;
+		ArrayView<float> vecs;
+		if(!useView && numPoints > 0)
+			vecs = bezier.readView<float>(bezTripleVec, numPoints);
 		for(int i=0; i<numPoints; i++) {
 			TempKeyFrame key;
-			key.points = bezier.readVec3fArray("vec");
+			if(useView) {
+				layout::BezTriple bezTriple = bezTriples[i];
+				for(unsigned int j=0; j<3; j++) {
+					key.points.push_back(ofVec3f(bezTriple.vec(j, 0), bezTriple.vec(j, 1), bezTriple.vec(j, 2)));
+				}
+				key.ipo = bezTriple.ipo();
+			} else {
+				for(unsigned int j=0; j<3 && (unsigned int)i<vecs.size() && vecs.getComponents() >= 9; j++) {
+					key.points.push_back(ofVec3f(vecs.get(i, j*3), vecs.get(i, j*3+1), vecs.get(i, j*3+2)));
+				}
+
+				key.ipo = bezier.read<short>(bezTripleIpo);
+				if(key.ipo > 4)
+					key.ipo = bezier.read<char>(bezTripleIpo);
+			}
 
-			key.ipo = bezier.read<short>("ipo");
-			if(key.ipo > 4)
-				key.ipo = bezier.read<char>("ipo");
+			//the fallback could not read the handles and the key of this triple
+			if(key.points.size() < 3) {
+				bezier.nextBlock();
+				continue;
+			}
 
 			//TODO: read proper frame rate
 			double fps = 24; //default blender frame rate
@@ -693,14 +926,15 @@ public:
 			return;
 
 		DNAStructureReader animReader(reader.file->getBlockByAddress(animDataAddress));
-		if(animReader.readAddress("action") == 0)
+		if(animReader.readAddress(animDataAction) == 0)
 			return;
 		
 		//load all curves
-		vector<DNAStructureReader> curves = animReader.readStructure("action").readLinkedList("curves");
+		vector<DNAStructureReader> curves = animReader.readStructure(animDataAction).readLinkedList(actionCurves);
 		for(DNAStructureReader& curve: curves) {
-			string rnaPath = curve.readString("rna_path");
-			int arrayIndex = curve.read<int>("array_index");
+			string rnaPath = curve.readString(fcurveRnaPath);
+			layout::FCurve fcurve = curve.getView<layout::FCurve>();
+			int arrayIndex = fcurve.isValid() ? fcurve.array_index() : curve.read<int>(fcurveArrayIndex);
 			string address = rnaPath;
 			int channel = arrayIndex;
 
@@ -713,7 +947,7 @@ public:
 			if(address == "location" || address == "rotation" || address == "scale" || address=="rotation_euler" || address=="lens") {
 
 				//create the animation, arrayIndex
-				Animation<float>* anim = new Animation<float>(address, arrayIndex);
+				Animation<float>* anim = reader.file->arena->create<Animation<float> >(address, arrayIndex);
 				for(TempKeyFrame& key: keyframes) {
 					if(key.ipo == 1)
 						anim->addKeyframe(key.time, key.points[1][1]);
@@ -728,7 +962,7 @@ public:
 
 			} else if(address == "hide_render") {
 
-				Animation<bool>* anim = new Animation<bool>(address, arrayIndex);
+				Animation<bool>* anim = reader.file->arena->create<Animation<bool> >(address, arrayIndex);
 
 				for(TempKeyFrame& key: keyframes) {
 
@@ -747,14 +981,24 @@ public:
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	static void parseObject(DNAStructureReader& reader, Object* object) {
-		reader.setStructure("id");
-		object->name = reader.readString("name");
+		reader.setStructure(objectId);
+		object->name = reader.readString(idName);
 		reader.reset();
 
-		ofLogNotice(OFX_BLENDER) << "Loading Object \"" << object->name << "\"";
+		ofLogVerbose(OFX_BLENDER) << "Loading Object \"" << object->name << "\"";
 
 		//get transformation
-		vector<vector<float> > matArray = reader.readMultArray<float>("obmat");
+		vector<vector<float> > matArray;
+		layout::Object objectView = reader.getView<layout::Object>();
+		if(objectView.isValid()) {
+			matArray.assign(4, vector<float>(4));
+			for(unsigned int i=0; i<4; i++) {
+				for(unsigned int j=0; j<4; j++)
+					matArray[i][j] = objectView.obmat(i, j);
+			}
+		} else {
+			matArray = reader.readMultArray<float>(objectObmat);
+		}
 		ofMatrix4x4 mat(matArray[0][0], matArray[0][1], matArray[0][2], matArray[0][3],
 		                matArray[1][0], matArray[1][1], matArray[1][2], matArray[1][3],
 		                matArray[2][0], matArray[2][1], matArray[2][2], matArray[2][3],
@@ -767,9 +1011,9 @@ public:
 		//cout << reader.read<short>("flag") << endl;
 
 		//check for parent
-		unsigned long parentAddress = reader.readAddress("parent");
+		unsigned long parentAddress = reader.readAddress(objectParent);
 		if(parentAddress != 0) {
-			DNAStructureReader parentReader = reader.readStructure("parent");
+			DNAStructureReader parentReader = reader.readStructure(objectParent);
 			Object* parent = static_cast<Object*>(parentReader.parse());
 			if(parent != NULL) {
 				object->setTransformMatrix(mat * ofMatrix4x4::getInverseOf(parent->getGlobalTransformMatrix()));
@@ -778,18 +1022,18 @@ public:
 		}
 
 		//check for constraints
-		for(DNAStructureReader& constraintReader: reader.readLinkedList("constraints")) {
-			string name = constraintReader.readString("name");
+		for(DNAStructureReader& constraintReader: reader.readLinkedList(objectConstraints)) {
+			string name = constraintReader.readString(constraintName);
 
-			DNAStructureReader data = constraintReader.readStructure("data");
-			if(data.getType() == "bTrackToConstraint") {
+			DNAStructureReader data = constraintReader.readStructure(constraintData);
+			if(data.isType(trackToType)) {
 
-				Object* target = static_cast<Object*>(data.readStructure("tar").parse());
+				Object* target = static_cast<Object*>(data.readStructure(trackToTar).parse());
 
 				if(target) {
-					ofLogNotice(OFX_BLENDER) << "Creating Track To Constraint " << object->name << " -> " << target->name;
+					ofLogVerbose(OFX_BLENDER) << "Creating Track To Constraint " << object->name << " -> " << target->name;
 
-					TrackToConstraint* constraint = new TrackToConstraint(target, ofVec3f(0, 0, 1));
+					TrackToConstraint* constraint = reader.file->arena->create<TrackToConstraint>(target, ofVec3f(0, 0, 1));
 					object->addConstraint(constraint);
 				}
 			}
@@ -813,11 +1057,11 @@ public:
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	static void parseMesh(DNAStructureReader& reader, Mesh* mesh) {
-		reader.setStructure("id");
-		mesh->meshName = reader.readString("name");
+		reader.setStructure(meshId);
+		mesh->meshName = reader.readString(idName);
 		reader.reset();
 
-		ofLogNotice(OFX_BLENDER) << "Loading Mesh \"" << mesh->name << "\"";
+		ofLogVerbose(OFX_BLENDER) << "Loading Mesh \"" << mesh->meshName << "\"";
 
 		/*
 		enum DrawFlag {
@@ -840,13 +1084,13 @@ public:
 
 
 		//get address of the polygon blocks
-		DNAStructureReader polyReader = reader.readStructure("mpoly");
+		DNAStructureReader polyReader = reader.readStructure(meshMpoly);
 
 		//get address of the loops blocks
-		DNAStructureReader loopReader = reader.readStructure("mloop");
+		DNAStructureReader loopReader = reader.readStructure(meshMloop);
 
 		//get address of the vertices blocks
-		DNAStructureReader vertReader = reader.readStructure("mvert");
+		DNAStructureReader vertReader = reader.readStructure(meshMvert);
 
 		//get address of the edge blocks
 		//DNAStructureReader edgeReader = reader.readStructure("medge");
@@ -855,15 +1099,24 @@ public:
 
 		//read all vertices and add to the mesh
 		mesh->clear();
-		unsigned int totalVertices = reader.read<int>("totvert");
-		for(unsigned int i=0; i<totalVertices; i++) {
-			mesh->addVertex(vertReader.readVec3f("co"), vertReader.readVec3<short>("no").getNormalized());
-			vertReader.nextBlock();
+		const LoadFilter& filter = reader.file->filter;
+		unsigned int totalVertices = filter.skipMeshData ? 0 : reader.read<int>(meshTotVert);
+		if(filter.skipMeshData || filter.boundsOnly) {
+			MeshArrays arrays;
+			if(totalVertices > 0)
+				arrays.decodeVertices(vertReader.readView<float>(mvertCo, totalVertices), ArrayView<short>());
+			arrays.positions.getBounds(mesh->boundsMin, mesh->boundsMax);
+			reader.file->progress.meshesBuilt++;
+			return;
 		}
+		//vertices, loops and polygons are decoded into flat arrays, one pass over each block
+		MeshArrays arrays;
+		if(totalVertices > 0)
+			arrays.decodeVertices(vertReader.readView<float>(mvertCo, totalVertices), vertReader.readView<short>(mvertNo, totalVertices));
 
 		//read all Materials
 		std::vector<Material*> materials;
-		std::vector<DNAStructureReader> materialStructs = reader.readLinkAsList("mat");
+		std::vector<DNAStructureReader> materialStructs = reader.readLinkAsList(meshMat);
 		for(DNAStructureReader& matReader: materialStructs) {
 			materials.push_back(static_cast<Material*>(matReader.parse()));
 		}
@@ -871,12 +1124,11 @@ public:
 		//try to read uv coordinates
 		bool hasUV = false;
 		std::vector<ofVec2f> defaultUvs;
-		if(reader.readAddress("mloopuv") != 0) {
-			DNAStructureReader uvReader = reader.readStructure("mloopuv");
-			for(unsigned int j=0; j<uvReader.count(); j++) {
-				defaultUvs.push_back(uvReader.readVec2f("uv"));
-				defaultUvs.back().y = 1 - defaultUvs.back().y;
-				uvReader.nextBlock();
+		if(reader.readAddress(meshMloopuv) != 0) {
+			DNAStructureReader uvReader = reader.readStructure(meshMloopuv);
+			ArrayView<float> uvs = uvReader.readView<float>(mloopUVUv);
+			for(unsigned int j=0; j<uvs.size() && uvs.getComponents() >= 2; j++) {
+				defaultUvs.push_back(ofVec2f(uvs.get(j, 0), 1 - uvs.get(j, 1)));
 			}
 			hasUV = true;
 		}
@@ -884,20 +1136,19 @@ public:
 		std::map<string, std::vector<ofVec2f> > uvLayers;
 
 		//read the layers
-		if(reader.readAddress("ldata") != 0) {
-			reader.setStructure("ldata");
-			int numLayers = reader.read<int>("totlayer");
-			DNAStructureReader layerReader = reader.readStructure("layers");
+		if(reader.readAddress(meshLdata) != 0) {
+			reader.setStructure(meshLdata);
+			int numLayers = reader.read<int>(customDataTotLayer);
+			DNAStructureReader layerReader = reader.readStructure(customDataLayers);
 			for(int i=0; i<numLayers; i++) {
-				DNAStructureReader layerData = layerReader.readStructure("data");
+				DNAStructureReader layerData = layerReader.readStructure(customDataLayerData);
 
 				//only interested in CD_MLOOPUV types (could also be CD_MPOLY)
-				if(layerData.getType() == "MLoopUV") {
-					string layerName = layerReader.readString("name");
-					for(unsigned int j=0; j<layerData.count(); j++) {
-						uvLayers[layerName].push_back(layerData.readVec2f("uv"));
-						uvLayers[layerName].back().y = 1 - uvLayers[layerName].back().y;
-						layerData.nextBlock();
+				if(layerData.isType(mloopUVType)) {
+					string layerName = layerReader.readString(customDataLayerName);
+					ArrayView<float> uvs = layerData.readView<float>(mloopUVUv);
+					for(unsigned int j=0; j<uvs.size() && uvs.getComponents() >= 2; j++) {
+						uvLayers[layerName].push_back(ofVec2f(uvs.get(j, 0), 1 - uvs.get(j, 1)));
 					}
 				}
 				layerReader.nextBlock();
@@ -906,40 +1157,40 @@ public:
 		}
 
 		//get the total number of polygons
-		int totalPolys = reader.read<int>("totpoly");
+		int totalPolys = reader.read<int>(meshTotPoly);
+		if(totalPolys > 0) {
+			arrays.decodePolygons(polyReader.readView<int>(mpolyLoopStart, totalPolys), polyReader.readView<int>(mpolyTotLoop, totalPolys),
+				polyReader.readView<short>(mpolyMatNr, totalPolys), polyReader.readView<char>(mpolyFlag, totalPolys));
+			arrays.decodeLoops(loopReader.readView<int>(mloopV));
+		}
 
-		ofVec3f e0, e1;
+		//meshes are already spread over the threads when parsing in parallel
+		arrays.triangulate(arrays.positions, reader.file->parallelParsing ? 1 : reader.file->numThreads);
+		mesh->setVertices(arrays.positions, arrays.normals);
+		mesh->reserveTriangles(arrays.polygonTriangles.back());
 
-		///
-		bool vertCountTooBig = false;
 		bool vertCountTooSmall = false;
 
 		//build triangles
-		for(int i=0; i<totalPolys; i++) {
-			unsigned int vertCount = polyReader.read<int>("totloop");
-			if (vertCount<3) {
+		for(unsigned int i=0; i<arrays.polygons.size(); i++) {
+			MeshArrays::Polygon& poly = arrays.polygons[i];
+			if(poly.numLoops < 3) {
 				vertCountTooSmall = true;
 				continue;
 			}
-			if (vertCount>4) {
-				vertCountTooBig = true;
-				continue;
-			}
 
 			//check the shading
 			Shading shading = FLAT;
-			//if(((int)polyReader.read<char>("flag")) == 3) {
-			if(polyReader.read<char>("flag") & ME_SMOOTH) {
+			if(poly.flag & ME_SMOOTH) {
 				shading = SMOOTH;
 			}
 
 			mesh->pushShading(shading);
 
 			//pick the material
-			unsigned int materialNumber = polyReader.read<short>("mat_nr");
 			Material* material = NULL;
-			if(materialNumber < materials.size()) {
-				material = materials[materialNumber];
+			if((unsigned short)poly.material < materials.size()) {
+				material = materials[poly.material];
 				mesh->pushMaterial(material);
 			}
 
@@ -955,79 +1206,18 @@ public:
 			if(!uvLayer && hasUV)
 				uvLayer = &defaultUvs;
 
-			//write triangles
-			int loopStart = polyReader.read<int>("loopstart");
-
-			if(vertCount == 4) {
-				loopReader.blockAt(loopStart);
-				unsigned int index0 = loopReader.read<int>("v");
-				loopReader.nextBlock();
-				unsigned int index1 = loopReader.read<int>("v");
-				loopReader.nextBlock();
-				unsigned int index2 = loopReader.read<int>("v");
-				loopReader.nextBlock();
-				unsigned int index3 = loopReader.read<int>("v");
-				//loopReader.nextBlock();
-
-				e0 = mesh->getVertex(index0) - mesh->getVertex(index1);
-				e1 = mesh->getVertex(index2) - mesh->getVertex(index3);
-
-				if(e0.lengthSquared() < e1.lengthSquared()) {
-
-					Mesh::Triangle tri1(index0, index1, index2);
-					if(uvLayer && uvLayer->size() > loopStart+2) {
-						tri1.addUVs(uvLayer->at(loopStart), uvLayer->at(loopStart+1), uvLayer->at(loopStart+2));
-					}
-					mesh->addTriangle(tri1);
-
-					Mesh::Triangle tri2(index2, index3, index0);
-					if(uvLayer && uvLayer->size() > loopStart+3) {
-						tri2.addUVs(uvLayer->at(loopStart+2), uvLayer->at(loopStart+3), uvLayer->at(loopStart));
-					}
-
-					mesh->addTriangle(tri2);
-
-				} else {
-					//mesh->addTriangle(index1, index2, index4);
-					//mesh->addTriangle(index4, index2, index3);
-
-					Mesh::Triangle tri1(index0, index1, index3);
-					if(uvLayer && uvLayer->size() > loopStart+3) {
-						tri1.addUVs(uvLayer->at(loopStart), uvLayer->at(loopStart+1), uvLayer->at(loopStart+3));
-					}
-					mesh->addTriangle(tri1);
-
-					Mesh::Triangle tri2(index3, index1, index2);
-					if(uvLayer && uvLayer->size() > loopStart+3) {
-						tri2.addUVs(uvLayer->at(loopStart+3), uvLayer->at(loopStart+1), uvLayer->at(loopStart+2));
-					}
-
-					mesh->addTriangle(tri2);
+			//write triangles, their corners are loops which index the vertices and the uvs
+			for(unsigned int t=arrays.polygonTriangles[i]; t<arrays.polygonTriangles[i + 1]; t++) {
+				const int* loops = &arrays.triangleLoops[t * 3];
+				Mesh::Triangle tri(arrays.loopVertices[loops[0]], arrays.loopVertices[loops[1]], arrays.loopVertices[loops[2]]);
+				if(uvLayer && uvLayer->size() > (unsigned int)std::max(loops[0], std::max(loops[1], loops[2]))) {
+					tri.addUVs(uvLayer->at(loops[0]), uvLayer->at(loops[1]), uvLayer->at(loops[2]));
 				}
-
-			} else {
-				loopReader.blockAt(loopStart);
-				unsigned int index0 = loopReader.read<int>("v");
-				loopReader.nextBlock();
-				unsigned int index1 = loopReader.read<int>("v");
-				loopReader.nextBlock();
-				unsigned int index2 = loopReader.read<int>("v");
-
-				//mesh->addTriangle(index1, index2, index3);
-				Mesh::Triangle tri1(index0, index1, index2);
-				if(uvLayer && uvLayer->size() > loopStart+2) {
-					tri1.addUVs(uvLayer->at(loopStart), uvLayer->at(loopStart+1), uvLayer->at(loopStart+2));
-				}
-				mesh->addTriangle(tri1);
+				mesh->addTriangle(tri);
 			}
-
-			//done, let's advance to the next polygon
-			polyReader.nextBlock();
 		}
 
 		//warnings
-		if(vertCountTooBig)
-			ofLogWarning(OFX_BLENDER) << "can't convert polygon with more than 4 vertices";
 		if(vertCountTooSmall)
 			ofLogWarning(OFX_BLENDER) << "can't convert polygon with only 2 or less vertices";
 
@@ -1036,7 +1226,13 @@ public:
 		//cout << "EXPORT" << endl;
 		//mesh->exportUVLayer(i);
 		//}
-		mesh->build();
+		if(reader.file->deferMeshBuilds) {
+			reader.file->deferMeshBuild(mesh);
+		} else {
+			Profiler::WorkScope scope(reader.file->profiler, LoadProfile::MESH_BUILD);
+			mesh->build();
+			reader.file->progress.meshesBuilt++;
+		}
 		//mesh->exportUVs();
 	}
 
@@ -1044,8 +1240,8 @@ public:
 #define TF_TWOSIDE 512
 
 	static void parseMaterial(DNAStructureReader& reader, Material* material) {
-		reader.setStructure("id");
-		material->name = reader.readString("name");
+		reader.setStructure(materialId);
+		material->name = reader.readString(idName);
 		reader.reset();
 
 		/*
@@ -1053,19 +1249,19 @@ public:
 		MA_WIREFRAME        = (1 << 2),
 		*/
 
-		ofLogNotice(OFX_BLENDER) << "Loading Material \"" << material->name << "\"";
+		ofLogVerbose(OFX_BLENDER) << "Loading Material \"" << material->name << "\"";
 
-		material->material.setShininess(reader.read<float>("spec"));
+		material->material.setShininess(reader.read<float>(materialSpec));
 
 
 		//TODO: why are those colors flipped?
-		material->material.setDiffuseColor(ofFloatColor(reader.read<float>("r"), reader.read<float>("g"), reader.read<float>("b")));
-		material->material.setAmbientColor(ofFloatColor(reader.read<float>("r"), reader.read<float>("g"), reader.read<float>("b")));
-		material->material.setSpecularColor(ofFloatColor(reader.read<float>("specr"), reader.read<float>("specg"), reader.read<float>("specb")));
+		material->material.setDiffuseColor(ofFloatColor(reader.read<float>(materialR), reader.read<float>(materialG), reader.read<float>(materialB)));
+		material->material.setAmbientColor(ofFloatColor(reader.read<float>(materialR), reader.read<float>(materialG), reader.read<float>(materialB)));
+		material->material.setSpecularColor(ofFloatColor(reader.read<float>(materialSpecR), reader.read<float>(materialSpecG), reader.read<float>(materialSpecB)));
 
 		//load textures
-		if(!reader.file->skipTextures) {
-			std::vector<DNAStructureReader> textures = reader.readStructureArray("mtex");
+		if(!reader.file->filter.skipTextures) {
+			std::vector<DNAStructureReader> textures = reader.readStructureArray(materialMtex);
 			for(DNAStructureReader& texReader: textures) {
 				Texture* texture = static_cast<Texture*>(texReader.parse());
 				if(texture->isEnabled && texture->img.isAllocated())
@@ -1078,16 +1274,16 @@ public:
 	}
 
 	static void parseTexture(DNAStructureReader& reader, Texture* texture) {
-		DNAStructureReader texReader = reader.readStructure("tex");
-		texReader.setStructure("id");
-		texture->name = texReader.readString("name");
+		DNAStructureReader texReader = reader.readStructure(mtexTex);
+		texReader.setStructure(texId);
+		texture->name = texReader.readString(idName);
 		texReader.reset();
 
-		ofLogNotice(OFX_BLENDER) << "Loading Texture \"" << texture->name << "\"";
+		ofLogVerbose(OFX_BLENDER) << "Loading Texture \"" << texture->name << "\"";
 
 		//cout << "FLAG " << (reader.read<short>("texflag") & 2) << endl;
 
-		texture->uvLayerName = reader.readString("uvname");
+		texture->uvLayerName = reader.readString(mtexUvName);
 		//reader.readString("uvname") << endl;
 
 		//there are many more types
@@ -1098,38 +1294,47 @@ public:
 		    IMAGE = 8
 		};
 
-		if(texReader.read<short>("type") != IMAGE) {
+		if(texReader.read<short>(texType) != IMAGE) {
 			ofLogWarning(OFX_BLENDER) << "CAN ONLY READ TEXTURES OF TYPE IMAGE \"" << texture->name << "\"";
 			return;
 		}
 
-		DNAStructureReader imgReader = texReader.readStructure("ima");
+		DNAStructureReader imgReader = texReader.readStructure(texIma);
 
-		//check if file is packed or has to be loaded
-		if(imgReader.readAddress("packedfile")) {
-			DNAStructureReader packedFile = imgReader.readStructure("packedfile");
-			unsigned int size = packedFile.read<int>("size");
-			DNAStructureReader dataBlock = packedFile.readStructure("data");
+		//on worker threads only the pixels are loaded, the texture is uploaded by the file afterwards
+		bool deferUpload = reader.file->deferTextureUpload && reader.file->uploadToGpu;
+		if(deferUpload || !reader.file->uploadToGpu)
+			texture->img.setUseTexture(false);
 
-			char* pixels = dataBlock.readChar("next", size);
-			ofBuffer buffer(pixels, size);
+		//check if file is packed or has to be loaded
+		Profiler::WorkScope scope(reader.file->profiler, LoadProfile::TEXTURE_DECODE);
+		if(imgReader.readAddress(imagePackedFile)) {
+			DNAStructureReader packedFile = imgReader.readStructure(imagePackedFile);
+			unsigned int size = packedFile.read<int>(packedFileSize);
+			DNAStructureReader dataBlock = packedFile.readStructure(packedFileData);
+
+			std::vector<char> pixels = dataBlock.readChar("next", size);
+			ofBuffer buffer(pixels.data(), size);
 			texture->img.loadImage(buffer);
 			//texture->img.saveImage(texture->name+".png");
 		} else {
-			string path = imgReader.readString("name");
+			string path = imgReader.readString(imageName);
 			ofStringReplace(path, "//", "");
 			texture->img.loadImage(path);
 		}
+
+		if(deferUpload && texture->img.isAllocated())
+			reader.file->deferTexture(texture);
 	}
 
 	//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	static void parseCamera(DNAStructureReader& reader, Camera* cam) {
 		ofCamera* camera = &cam->camera;
 
-		cam->setLens(reader.read<float>("lens"));
+		cam->setLens(reader.read<float>(cameraLens));
 
-		camera->setNearClip(reader.read<float>("clipsta"));
-		camera->setFarClip(reader.read<float>("clipend"));
+		camera->setNearClip(reader.read<float>(cameraClipSta));
+		camera->setFarClip(reader.read<float>(cameraClipEnd));
 
 		parseAnimationData(reader, &cam->timeline);
 
@@ -1148,25 +1353,25 @@ public:
 
 		//TODO: the lights get kind of parsed, but there is lots to do, best would be to use blenders shaders
 
-		unsigned int type = reader.read<short>("type");
+		unsigned int type = reader.read<short>(lampType);
 		if(type == BL_POINT) {
 			light->light.setPointLight();
-			float energy = reader.read<float>("energy");
+			float energy = reader.read<float>(lampEnergy);
 			if(energy == 0)
 				energy = .00001;
-			float distance = 1.f / reader.read<float>("dist");
-			light->light.setAttenuation(1.f / energy, reader.read<float>("att1") * distance, reader.read<float>("att2") * distance);
+			float distance = 1.f / reader.read<float>(lampDist);
+			light->light.setAttenuation(1.f / energy, reader.read<float>(lampAtt1) * distance, reader.read<float>(lampAtt2) * distance);
 		} else if(type == BL_SUN) {
 			light->light.setDirectional();
 			light->light.tilt(180);
 		} else if(type == BL_SPOT) {
-			light->light.setSpotlight(ofRadToDeg(reader.read<float>("spotsize"))*.5, (1-reader.read<float>("spotblend"))*128);
+			light->light.setSpotlight(ofRadToDeg(reader.read<float>(lampSpotSize))*.5, (1-reader.read<float>(lampSpotBlend))*128);
 		} else if(type == BL_HEMI) {
 		} else {
 			ofLogWarning(OFX_BLENDER) << "Light \"" << light->name << "\" has an unsupported type";
 		}
 
-		light->light.setDiffuseColor(ofFloatColor(reader.read<float>("r"), reader.read<float>("g"), reader.read<float>("b")));
+		light->light.setDiffuseColor(ofFloatColor(reader.read<float>(lampR), reader.read<float>(lampG), reader.read<float>(lampB)));
 	}
 
 	static void* parseFileBlock(File::Block* block) {
@@ -1174,21 +1379,116 @@ public:
 	}
 
 	static void* parseFileBlock(File::Block* block, void* obj) {
-		if(handlers.find(block->structure->type->name) != handlers.end()) {
+		Handler_* handler = getHandler(block);
+		if(handler) {
+			Profiler::BlockScope scope(block->file->profiler, block->structure->type->name);
 			DNAStructureReader reader = DNAStructureReader(block);
 			if(obj == NULL)
-				return handlers[block->structure->type->name]->call(reader);
+				return handler->call(reader);
 			else
-				return handlers[block->structure->type->name]->call(reader, obj);
+				return handler->call(reader, obj);
 		}
 		ofLogWarning(OFX_BLENDER) << "No Parser for Object Type \"" << block->structure->type->name << "\" found";
 		return NULL;
 	}
 
 private:
-	typedef std::map<std::string, Handler_*> HandlerList;
+	typedef std::vector<std::pair<StructHandle, Handler_*> > HandlerList;
 	static HandlerList handlers;
+	static ObjectHandler* objectHandler;
 	static bool isInit;
+
+	//fields read in the per vertex, polygon and keyframe loops
+	static FieldHandle objectType;
+	static FieldHandle objectData;
+	static FieldHandle bezTripleVec;
+	static FieldHandle bezTripleIpo;
+	static FieldHandle mvertCo;
+	static FieldHandle mvertNo;
+	static FieldHandle mpolyTotLoop;
+	static FieldHandle mpolyFlag;
+	static FieldHandle mpolyMatNr;
+	static FieldHandle mpolyLoopStart;
+	static FieldHandle mloopV;
+	static FieldHandle mloopUVUv;
+	static StructHandle mloopUVType;
+	static StructHandle trackToType;
+
+	//fields read once per scene, object, material, texture, camera, light or curve
+	static FieldHandle idName;
+	static FieldHandle sceneId;
+	static FieldHandle sceneR;
+	static FieldHandle sceneBase;
+	static FieldHandle sceneCamera;
+	static FieldHandle sceneWorld;
+	static FieldHandle sceneMarkers;
+	static FieldHandle renderFrsSec;
+	static FieldHandle renderEfra;
+	static FieldHandle baseObject;
+	static FieldHandle baseNext;
+	static FieldHandle worldHorR;
+	static FieldHandle worldHorG;
+	static FieldHandle worldHorB;
+	static FieldHandle markerFrame;
+	static FieldHandle markerName;
+	static FieldHandle animDataAction;
+	static FieldHandle actionCurves;
+	static FieldHandle fcurveTotVert;
+	static FieldHandle fcurveBezt;
+	static FieldHandle fcurveRnaPath;
+	static FieldHandle fcurveArrayIndex;
+	static FieldHandle objectId;
+	static FieldHandle objectLay;
+	static FieldHandle objectObmat;
+	static FieldHandle objectParent;
+	static FieldHandle objectConstraints;
+	static FieldHandle constraintName;
+	static FieldHandle constraintData;
+	static FieldHandle trackToTar;
+	static FieldHandle meshId;
+	static FieldHandle meshMpoly;
+	static FieldHandle meshMloop;
+	static FieldHandle meshMvert;
+	static FieldHandle meshMloopuv;
+	static FieldHandle meshLdata;
+	static FieldHandle meshTotVert;
+	static FieldHandle meshTotPoly;
+	static FieldHandle meshMat;
+	static FieldHandle customDataTotLayer;
+	static FieldHandle customDataLayers;
+	static FieldHandle customDataLayerData;
+	static FieldHandle customDataLayerName;
+	static FieldHandle materialId;
+	static FieldHandle materialSpec;
+	static FieldHandle materialR;
+	static FieldHandle materialG;
+	static FieldHandle materialB;
+	static FieldHandle materialSpecR;
+	static FieldHandle materialSpecG;
+	static FieldHandle materialSpecB;
+	static FieldHandle materialMtex;
+	static FieldHandle mtexTex;
+	static FieldHandle mtexUvName;
+	static FieldHandle texId;
+	static FieldHandle texType;
+	static FieldHandle texIma;
+	static FieldHandle imageName;
+	static FieldHandle imagePackedFile;
+	static FieldHandle packedFileSize;
+	static FieldHandle packedFileData;
+	static FieldHandle cameraLens;
+	static FieldHandle cameraClipSta;
+	static FieldHandle cameraClipEnd;
+	static FieldHandle lampType;
+	static FieldHandle lampEnergy;
+	static FieldHandle lampDist;
+	static FieldHandle lampAtt1;
+	static FieldHandle lampAtt2;
+	static FieldHandle lampSpotSize;
+	static FieldHandle lampSpotBlend;
+	static FieldHandle lampR;
+	static FieldHandle lampG;
+	static FieldHandle lampB;
 };
 
 }
@@ -0,0 +1,183 @@
+#include "Profiler.h"
+#include <sstream>
+
+namespace ofx {
+namespace blender {
+
+string LoadProfile::getPhaseName(Phase phase) {
+	static const char* names[NUM_PHASES] = {
+		"inflate", "headerScan", "dnaParse", "indexBuild", "meshBuild", "textureDecode"
+	};
+	if(phase < 0 || phase >= NUM_PHASES)
+		return "";
+	return names[phase];
+}
+
+static void writeTiming(std::ostream& out, const LoadProfile::Timing& timing) {
+	out << "{\"count\": " << timing.count << ", \"ms\": " << timing.millis << ", \"selfMs\": " << timing.selfMillis << "}";
+}
+
+static void writePhaseTiming(std::ostream& out, const LoadProfile::Timing& timing) {
+	out << "{\"count\": " << timing.count << ", \"ms\": " << timing.millis << ", \"threadMs\": " << timing.threadMillis << "}";
+}
+
+static void writeJsonString(std::ostream& out, const string& value) {
+	out << '"';
+	for(char c: value) {
+		if(c == '"' || c == '\\')
+			out << '\\';
+		if((unsigned char)c >= 0x20)
+			out << c;
+	}
+	out << '"';
+}
+
+string LoadProfile::toJson() const {
+	std::ostringstream out;
+	out << "{\n\t\"phases\": {";
+	for(unsigned int i=0; i<NUM_PHASES; i++) {
+		out << (i == 0 ? "\n" : ",\n") << "\t\t";
+		writeJsonString(out, getPhaseName(Phase(i)));
+		out << ": ";
+		writePhaseTiming(out, phases[i]);
+	}
+	out << "\n\t},\n\t\"blockTypes\": {";
+	bool first = true;
+	for(const std::pair<const string, Timing>& type: blockTypes) {
+		out << (first ? "\n" : ",\n") << "\t\t";
+		writeJsonString(out, type.first);
+		out << ": ";
+		writeTiming(out, type.second);
+		first = false;
+	}
+	out << "\n\t},\n";
+	out << "\t\"seeks\": " << seeks << ",\n";
+	out << "\t\"bytesRead\": " << bytesRead << ",\n";
+	out << "\t\"addressLookups\": " << addressLookups << ",\n";
+	out << "\t\"cacheHits\": " << cacheHits << ",\n";
+	out << "\t\"cacheMisses\": " << cacheMisses << "\n";
+	out << "}\n";
+	return out.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//time of the blocks parsed within the innermost BlockScope of this thread
+static thread_local unsigned long long nestedBlockTime = 0;
+
+Profiler::Profiler() {
+	enabled = false;
+	reset();
+}
+
+void Profiler::reset() {
+	for(unsigned int i=0; i<LoadProfile::NUM_PHASES; i++) {
+		phaseMicros[i] = 0;
+		phaseCounts[i] = 0;
+		phaseThreadMicros[i] = 0;
+		openPhases[i] = 0;
+	}
+	seeks = 0;
+	bytesRead = 0;
+	addressLookups = 0;
+	cacheHits = 0;
+	cacheMisses = 0;
+	std::lock_guard<std::mutex> lock(mutex);
+	blockTimes.clear();
+}
+
+LoadProfile Profiler::getProfile() {
+	LoadProfile profile;
+	for(unsigned int i=0; i<LoadProfile::NUM_PHASES; i++) {
+		profile.phases[i].count = phaseCounts[i];
+		profile.phases[i].millis = phaseMicros[i] / 1000.0;
+		profile.phases[i].selfMillis = profile.phases[i].millis;
+		profile.phases[i].threadMillis = phaseThreadMicros[i] / 1000.0;
+	}
+	profile.seeks = seeks;
+	profile.bytesRead = bytesRead;
+	profile.addressLookups = addressLookups;
+	profile.cacheHits = cacheHits;
+	profile.cacheMisses = cacheMisses;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	for(const std::pair<const string, BlockTiming>& type: blockTimes) {
+		LoadProfile::Timing& timing = profile.blockTypes[type.first];
+		timing.count = type.second.count;
+		timing.millis = type.second.micros / 1000.0;
+		timing.selfMillis = type.second.selfMicros / 1000.0;
+	}
+	return profile;
+}
+
+void Profiler::addTime(LoadProfile::Phase phase, unsigned long long micros) {
+	phaseMicros[phase] += micros;
+	phaseCounts[phase]++;
+}
+
+void Profiler::addThreadTime(LoadProfile::Phase phase, unsigned long long micros) {
+	phaseThreadMicros[phase] += micros;
+}
+
+void Profiler::addBlockTime(const string& type, unsigned long long micros, unsigned long long selfMicros) {
+	std::lock_guard<std::mutex> lock(mutex);
+	std::map<string, BlockTiming>::iterator it = blockTimes.find(type);
+	if(it == blockTimes.end()) {
+		BlockTiming timing = {0, 0, 0};
+		it = blockTimes.insert(std::make_pair(type, timing)).first;
+	}
+	it->second.count++;
+	it->second.micros += micros;
+	it->second.selfMicros += selfMicros;
+}
+
+Profiler::PhaseScope::PhaseScope(Profiler& p, LoadProfile::Phase ph):profiler(p), phase(ph) {
+	active = profiler.isEnabled();
+	startTime = active ? ofGetElapsedTimeMicros() : 0;
+	if(active)
+		profiler.openPhases[phase]++;
+}
+
+Profiler::PhaseScope::~PhaseScope() {
+	if(!active)
+		return;
+	profiler.openPhases[phase]--;
+	profiler.addTime(phase, ofGetElapsedTimeMicros() - startTime);
+}
+
+Profiler::WorkScope::WorkScope(Profiler& p, LoadProfile::Phase ph):profiler(p), phase(ph) {
+	active = profiler.isEnabled();
+	startTime = active ? ofGetElapsedTimeMicros() : 0;
+}
+
+Profiler::WorkScope::~WorkScope() {
+	if(!active)
+		return;
+	unsigned long long elapsed = ofGetElapsedTimeMicros() - startTime;
+	profiler.addThreadTime(phase, elapsed);
+	if(profiler.openPhases[phase] == 0)
+		profiler.addTime(phase, elapsed);
+}
+
+Profiler::BlockScope::BlockScope(Profiler& p, const string& t):profiler(p), type(t) {
+	active = profiler.isEnabled();
+	startTime = 0;
+	outerNestedTime = 0;
+	if(active) {
+		outerNestedTime = nestedBlockTime;
+		nestedBlockTime = 0;
+		startTime = ofGetElapsedTimeMicros();
+	}
+}
+
+Profiler::BlockScope::~BlockScope() {
+	if(!active)
+		return;
+	unsigned long long elapsed = ofGetElapsedTimeMicros() - startTime;
+	unsigned long long nested = std::min(nestedBlockTime, elapsed);
+	profiler.addBlockTime(type, elapsed, elapsed - nested);
+	nestedBlockTime = outerNestedTime + elapsed;
+}
+
+}
+}
@@ -0,0 +1,166 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "Utils.h"
+#include <atomic>
+#include <mutex>
+#include <map>
+
+namespace ofx {
+namespace blender {
+
+//timings and I/O counters of the last load and of everything parsed from it since, see File::getProfile
+struct LoadProfile
+{
+	enum Phase {
+		//gzip or zstd decompression
+		INFLATE,
+		//reading the block headers (or restoring them from the index cache)
+		HEADER_SCAN,
+		//reading the SDNA catalog
+		DNA_PARSE,
+		//address, type and name indices, reachability and writing the index cache
+		INDEX_BUILD,
+		MESH_BUILD,
+		TEXTURE_DECODE,
+		NUM_PHASES
+	};
+
+	struct Timing {
+		Timing():count(0), millis(0), selfMillis(0), threadMillis(0) {}
+		unsigned int count;
+		//wall clock time
+		double millis;
+		//without the time spent in nested blocks (e.g. the mesh of an object), the same as millis for phases
+		double selfMillis;
+		//of the phases that are worked on by several threads (meshBuild, textureDecode): the time of all threads
+		//added up, more than millis when they run in parallel
+		double threadMillis;
+	};
+
+	LoadProfile():seeks(0), bytesRead(0), addressLookups(0), cacheHits(0), cacheMisses(0) {}
+
+	static string getPhaseName(Phase phase);
+	string toJson() const;
+
+	Timing phases[NUM_PHASES];
+	//block parsing by SDNA type name (Object, Mesh, Material...)
+	std::map<string, Timing> blockTypes;
+	//stream repositionings, files in memory don't seek
+	unsigned long long seeks;
+	unsigned long long bytesRead;
+	//getBlockByAddress calls
+	unsigned long long addressLookups;
+	//blocks requested again after they were parsed and blocks parsed for the first time
+	unsigned long long cacheHits;
+	unsigned long long cacheMisses;
+};
+
+//collects a LoadProfile, the counters can be updated from several threads. nothing is recorded unless it is enabled
+class Profiler {
+public:
+	Profiler();
+
+	void reset();
+	LoadProfile getProfile();
+
+	bool isEnabled() {
+		return enabled;
+	}
+
+	void setEnabled(bool state) {
+		enabled = state;
+	}
+
+	void addTime(LoadProfile::Phase phase, unsigned long long micros);
+	void addThreadTime(LoadProfile::Phase phase, unsigned long long micros);
+	void addBlockTime(const string& type, unsigned long long micros, unsigned long long selfMicros);
+	void countSeek() {
+		if(enabled)
+			seeks++;
+	}
+	void countBytes(size_t numBytes) {
+		if(enabled)
+			bytesRead += numBytes;
+	}
+	void countAddressLookup() {
+		if(enabled)
+			addressLookups++;
+	}
+	void countCacheHit() {
+		if(enabled)
+			cacheHits++;
+	}
+	void countCacheMiss() {
+		if(enabled)
+			cacheMisses++;
+	}
+
+	//adds the time until it goes out of scope to a phase, put around the whole parallel section of a phase
+	class PhaseScope {
+	public:
+		PhaseScope(Profiler& p, LoadProfile::Phase ph);
+		~PhaseScope();
+	private:
+		Profiler& profiler;
+		LoadProfile::Phase phase;
+		bool active;
+		unsigned long long startTime;
+	};
+
+	//adds the time of one thread until it goes out of scope to the thread time of a phase, e.g. building one mesh.
+	//outside of a PhaseScope of the same phase it is added to the wall clock time as well
+	class WorkScope {
+	public:
+		WorkScope(Profiler& p, LoadProfile::Phase ph);
+		~WorkScope();
+	private:
+		Profiler& profiler;
+		LoadProfile::Phase phase;
+		bool active;
+		unsigned long long startTime;
+	};
+
+	//adds the time until it goes out of scope to a block type, blocks parsed within the scope on the same thread
+	//are subtracted from its self time
+	class BlockScope {
+	public:
+		BlockScope(Profiler& p, const string& t);
+		~BlockScope();
+	private:
+		Profiler& profiler;
+		const string& type;
+		bool active;
+		unsigned long long startTime;
+		unsigned long long outerNestedTime;
+	};
+
+private:
+	Profiler(const Profiler&);
+	Profiler& operator=(const Profiler&);
+
+	bool enabled;
+	std::atomic<unsigned long long> phaseMicros[LoadProfile::NUM_PHASES];
+	std::atomic<unsigned int> phaseCounts[LoadProfile::NUM_PHASES];
+	std::atomic<unsigned long long> phaseThreadMicros[LoadProfile::NUM_PHASES];
+	//PhaseScopes that are open
+	std::atomic<unsigned int> openPhases[LoadProfile::NUM_PHASES];
+	std::atomic<unsigned long long> seeks;
+	std::atomic<unsigned long long> bytesRead;
+	std::atomic<unsigned long long> addressLookups;
+	std::atomic<unsigned long long> cacheHits;
+	std::atomic<unsigned long long> cacheMisses;
+
+	struct BlockTiming {
+		unsigned int count;
+		unsigned long long micros;
+		unsigned long long selfMicros;
+	};
+	std::map<string, BlockTiming> blockTimes;
+	std::mutex mutex;
+};
+
+}
+}
+
+#endif // PROFILER_H
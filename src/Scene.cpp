@@ -1,4 +1,5 @@
 #include "Scene.h"
+#include <set>
 
 namespace ofx {
 
@@ -198,7 +199,7 @@ void Scene::addObject(Object* obj) {
 
 	obj->scene = this;
 
-	ofLogNotice(OFX_BLENDER) << "Added object " << obj->name << " to scene " << name;
+	ofLogVerbose(OFX_BLENDER) << "Added object " << obj->name << " to scene " << name;
 }
 
 //templated helper to retrieve objects
@@ -243,6 +244,15 @@ std::vector<Mesh*> Scene::getMeshes() {
 	return meshes;
 }
 
+void Scene::buildAll(unsigned int numThreads) {
+	std::vector<Mesh*> unbuilt;
+	for(Mesh* mesh: meshes) {
+		if(!mesh->isBuilt())
+			unbuilt.push_back(mesh);
+	}
+	Mesh::buildAll(unbuilt, numThreads);
+}
+
 Camera* Scene::getCamera(string name) {
 	return getFromVecByName<Camera>(cameras, name);
 }
@@ -280,6 +290,37 @@ void Scene::setLightningEnabled(bool state) {
 	doLightning = state;
 }
 
+MemoryReport Scene::getMemoryReport() {
+	MemoryReport report;
+	report.add(MemoryReport::NAMES, name, MemoryReport::getBytes(name));
+	timeline.addMemoryUsage(report, name);
+
+	for(Object* obj: objects) {
+		if(obj->type == MESH)
+			static_cast<Mesh*>(obj)->addMemoryUsage(report);
+		else
+			report.add(MemoryReport::NAMES, obj->name, MemoryReport::getBytes(obj->name));
+		obj->timeline.addMemoryUsage(report, obj->name);
+	}
+
+	//textures can be shared by several materials
+	std::set<Texture*> textures;
+	for(Material* material: materials) {
+		report.add(MemoryReport::NAMES, material->name, MemoryReport::getBytes(material->name));
+		for(Texture* texture: material->textures) {
+			if(!textures.insert(texture).second)
+				continue;
+			ofPixels& pixels = texture->img.getPixelsRef();
+			size_t bytes = pixels.getWidth() * pixels.getHeight() * pixels.getBytesPerPixel();
+			report.add(MemoryReport::TEXTURE_PIXELS, texture->name, bytes);
+			if(texture->img.getTextureReference().isAllocated())
+				report.add(MemoryReport::GPU_TEXTURES, texture->name, bytes);
+			report.add(MemoryReport::NAMES, texture->name, MemoryReport::getBytes(texture->name) + MemoryReport::getBytes(texture->uvLayerName));
+		}
+	}
+	return report;
+}
+
 //viewport
 void Scene::setViewport(float x, float y, float w, float h) {
 	bHasViewport = true;
@@ -29,11 +29,16 @@ public:
 	Mesh* getMesh(unsigned int index);
 	Mesh* getMesh(string name);
 	std::vector<Mesh*> getMeshes();
+	//builds the meshes that are not built yet with Mesh::buildAll, they are uploaded when first drawn
+	void buildAll(unsigned int numThreads=0);
 	Camera* getCamera(string name);
 	Camera* getCamera(unsigned int index);
 	Light* getLight(string name);
 	Light* getLight(unsigned int index);
 	void setLightningEnabled(bool state);
+
+	//memory used by the objects, meshes, textures and animations of the scene
+	MemoryReport getMemoryReport();
 	
 	//will try to draw non alpha objects before alpha
 	void enableAlphaOrdering();
@@ -0,0 +1,120 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace ofx {
+namespace blender {
+
+struct ThreadPool::Job {
+	const std::function<void(unsigned int)>* func;
+	unsigned int count;
+	//workers allowed on the job and workers that joined it, guarded by the mutex of the pool
+	unsigned int maxHelpers;
+	unsigned int helpers;
+	std::atomic<unsigned int> next;
+	std::atomic<unsigned int> finished;
+	std::mutex mutex;
+	std::condition_variable done;
+};
+
+ThreadPool& ThreadPool::get() {
+	static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+	return pool;
+}
+
+ThreadPool::ThreadPool(unsigned int numWorkers):stopping(false) {
+	for(unsigned int i=0; i<numWorkers; i++)
+		workers.push_back(std::thread(&ThreadPool::work, this));
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+	for(std::thread& worker: workers)
+		worker.join();
+}
+
+unsigned int ThreadPool::getNumWorkers() {
+	return workers.size();
+}
+
+void ThreadPool::run(unsigned int count, const std::function<void(unsigned int)>& func, unsigned int numThreads) {
+	if(numThreads == 0)
+		numThreads = workers.size() + 1;
+	unsigned int maxHelpers = std::min<unsigned int>(workers.size(), std::min(numThreads, count) - std::min(1u, count));
+
+	if(maxHelpers == 0) {
+		for(unsigned int i=0; i<count; i++)
+			func(i);
+		return;
+	}
+
+	std::shared_ptr<Job> job(new Job());
+	job->func = &func;
+	job->count = count;
+	job->maxHelpers = maxHelpers;
+	job->helpers = 0;
+	job->next = 0;
+	job->finished = 0;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push_back(job);
+	}
+	if(maxHelpers == 1)
+		condition.notify_one();
+	else
+		condition.notify_all();
+
+	process(*job);
+
+	//all indices are taken, the ones still running belong to workers which finish them without waiting for us
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.erase(std::remove(jobs.begin(), jobs.end(), job), jobs.end());
+	}
+	std::unique_lock<std::mutex> lock(job->mutex);
+	job->done.wait(lock, [&]() { return job->finished == job->count; });
+}
+
+void ThreadPool::process(Job& job) {
+	unsigned int i;
+	while((i = job.next++) < job.count) {
+		(*job.func)(i);
+		if(++job.finished == job.count) {
+			std::lock_guard<std::mutex> lock(job.mutex);
+			job.done.notify_all();
+		}
+	}
+}
+
+void ThreadPool::work() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true) {
+		//the oldest job with indices left that still takes helpers
+		std::shared_ptr<Job> job;
+		for(std::shared_ptr<Job>& candidate: jobs) {
+			if(candidate->helpers < candidate->maxHelpers && candidate->next < candidate->count) {
+				job = candidate;
+				break;
+			}
+		}
+		if(!job) {
+			if(stopping)
+				return;
+			condition.wait(lock);
+			continue;
+		}
+
+		job->helpers++;
+		lock.unlock();
+		process(*job);
+		lock.lock();
+	}
+}
+
+}
+}
@@ -0,0 +1,46 @@
+#ifndef BLENDER_THREADPOOL_H
+#define BLENDER_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ofx {
+namespace blender {
+
+//worker threads started once and shared by every parallelFor, so loading a scene doesn't start and join new
+//threads for each of its parallel sections. the calling thread works on its own loop as well, which makes nested
+//loops (e.g. triangulating inside a mesh build) safe: every index that is waited for is run by a busy thread
+class ThreadPool {
+public:
+	//the pool of the process with one worker less than there are cores, started on first use
+	static ThreadPool& get();
+
+	ThreadPool(unsigned int numWorkers);
+	~ThreadPool();
+
+	//calls func for every index in [0, count) on the calling thread and at most numThreads - 1 workers (0 = all)
+	void run(unsigned int count, const std::function<void(unsigned int)>& func, unsigned int numThreads=0);
+
+	unsigned int getNumWorkers();
+
+private:
+	struct Job;
+
+	void work();
+	void process(Job& job);
+
+	std::vector<std::thread> workers;
+	std::vector<std::shared_ptr<Job> > jobs;
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool stopping;
+};
+
+}
+}
+
+#endif // BLENDER_THREADPOOL_H
@@ -1,4 +1,5 @@
 #include "Utils.h"
+#include "ThreadPool.h"
 
 #include <algorithm>
 #include <iostream>
@@ -23,5 +24,9 @@ namespace blender{
 		return ltrim(rtrim(s));
 	}
 
+	void parallelFor(unsigned int count, std::function<void(unsigned int)> func, unsigned int numThreads) {
+		ThreadPool::get().run(count, func, numThreads);
+	}
+
 }
 }
\ No newline at end of file
@@ -10,6 +10,10 @@ namespace blender {
 
 	std::string &trim(std::string &s);
 
+	//calls func for every index in [0, count) spread over numThreads threads (0 = all cores), returns when all calls are done.
+	//the threads are the calling one and the workers of ThreadPool::get(), which are started once and reused
+	void parallelFor(unsigned int count, std::function<void(unsigned int)> func, unsigned int numThreads=0);
+
 }
 }
 #endif // LOADER_H
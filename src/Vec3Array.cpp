@@ -0,0 +1,252 @@
+#include "Vec3Array.h"
+#include "MemoryReport.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define OFX_BLENDER_SSE2
+#endif
+
+namespace ofx {
+namespace blender {
+
+#ifdef OFX_BLENDER_SSE2
+//x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to the x, y and z of the four vectors
+static inline void deinterleave(__m128 f0, __m128 f1, __m128 f2, __m128& x, __m128& y, __m128& z) {
+	x = _mm_shuffle_ps(f0, _mm_shuffle_ps(f1, f2, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(f0, f1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(f1, f2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(f0, f1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(f2, f2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+//same operations as ofVec3f::getNormalized
+static inline void normalizeVectors(__m128& x, __m128& y, __m128& z) {
+	__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+	__m128 valid = _mm_cmpgt_ps(length, _mm_setzero_ps());
+	x = _mm_and_ps(valid, _mm_div_ps(x, length));
+	y = _mm_and_ps(valid, _mm_div_ps(y, length));
+	z = _mm_and_ps(valid, _mm_div_ps(z, length));
+}
+#endif
+
+static void getRange(const std::vector<float>& values, float& min, float& max) {
+	size_t i = 0;
+	min = max = values[0];
+#ifdef OFX_BLENDER_SSE2
+	if(values.size() >= 4) {
+		__m128 lower = _mm_loadu_ps(&values[0]);
+		__m128 upper = lower;
+		for(i=4; i + 4 <= values.size(); i += 4) {
+			__m128 v = _mm_loadu_ps(&values[i]);
+			lower = _mm_min_ps(lower, v);
+			upper = _mm_max_ps(upper, v);
+		}
+		float lowers[4], uppers[4];
+		_mm_storeu_ps(lowers, lower);
+		_mm_storeu_ps(uppers, upper);
+		for(unsigned int j=0; j<4; j++) {
+			min = std::min(min, lowers[j]);
+			max = std::max(max, uppers[j]);
+		}
+	}
+#endif
+	for(; i<values.size(); i++) {
+		min = std::min(min, values[i]);
+		max = std::max(max, values[i]);
+	}
+}
+
+size_t Vec3Array::size() const {
+	return x.size();
+}
+
+bool Vec3Array::empty() const {
+	return x.empty();
+}
+
+void Vec3Array::resize(size_t size) {
+	x.resize(size);
+	y.resize(size);
+	z.resize(size);
+}
+
+void Vec3Array::reserve(size_t size) {
+	x.reserve(size);
+	y.reserve(size);
+	z.reserve(size);
+}
+
+void Vec3Array::clear() {
+	x.clear();
+	y.clear();
+	z.clear();
+}
+
+void Vec3Array::swap(Vec3Array& other) {
+	x.swap(other.x);
+	y.swap(other.y);
+	z.swap(other.z);
+}
+
+void Vec3Array::push_back(const ofVec3f& v) {
+	x.push_back(v.x);
+	y.push_back(v.y);
+	z.push_back(v.z);
+}
+
+ofVec3f Vec3Array::get(size_t index) const {
+	return ofVec3f(x[index], y[index], z[index]);
+}
+
+void Vec3Array::set(size_t index, const ofVec3f& v) {
+	x[index] = v.x;
+	y[index] = v.y;
+	z[index] = v.z;
+}
+
+void Vec3Array::setInterleaved(const float* values, size_t count) {
+	resize(count);
+	size_t i = 0;
+#ifdef OFX_BLENDER_SSE2
+	for(; i + 4 <= count; i += 4) {
+		__m128 vx, vy, vz;
+		deinterleave(_mm_loadu_ps(values + i * 3), _mm_loadu_ps(values + i * 3 + 4), _mm_loadu_ps(values + i * 3 + 8), vx, vy, vz);
+		_mm_storeu_ps(&x[i], vx);
+		_mm_storeu_ps(&y[i], vy);
+		_mm_storeu_ps(&z[i], vz);
+	}
+#endif
+	for(; i<count; i++) {
+		x[i] = values[i * 3];
+		y[i] = values[i * 3 + 1];
+		z[i] = values[i * 3 + 2];
+	}
+}
+
+void Vec3Array::getInterleaved(std::vector<ofVec3f>& out) const {
+	out.resize(size());
+	for(size_t i=0; i<out.size(); i++)
+		out[i].set(x[i], y[i], z[i]);
+}
+
+void Vec3Array::setNormalized(const short* values, size_t count) {
+	resize(count);
+	size_t i = 0;
+#ifdef OFX_BLENDER_SSE2
+	for(; i + 4 <= count; i += 4) {
+		//12 shorts sign extended to ints and converted
+		__m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i * 3));
+		__m128i last = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + i * 3 + 8));
+		__m128 f0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(first, first), 16));
+		__m128 f1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(first, first), 16));
+		__m128 f2 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(last, last), 16));
+
+		__m128 vx, vy, vz;
+		deinterleave(f0, f1, f2, vx, vy, vz);
+		normalizeVectors(vx, vy, vz);
+		_mm_storeu_ps(&x[i], vx);
+		_mm_storeu_ps(&y[i], vy);
+		_mm_storeu_ps(&z[i], vz);
+	}
+#endif
+	for(; i<count; i++)
+		set(i, ofVec3f(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]).getNormalized());
+}
+
+bool Vec3Array::getBounds(ofVec3f& min, ofVec3f& max) const {
+	if(empty())
+		return false;
+	getRange(x, min.x, max.x);
+	getRange(y, min.y, max.y);
+	getRange(z, min.z, max.z);
+	return true;
+}
+
+void Vec3Array::normalize() {
+	size_t i = 0;
+#ifdef OFX_BLENDER_SSE2
+	for(; i + 4 <= size(); i += 4) {
+		__m128 vx = _mm_loadu_ps(&x[i]);
+		__m128 vy = _mm_loadu_ps(&y[i]);
+		__m128 vz = _mm_loadu_ps(&z[i]);
+		normalizeVectors(vx, vy, vz);
+		_mm_storeu_ps(&x[i], vx);
+		_mm_storeu_ps(&y[i], vy);
+		_mm_storeu_ps(&z[i], vz);
+	}
+#endif
+	for(; i<size(); i++)
+		set(i, get(i).getNormalized());
+}
+
+void Vec3Array::setFaceNormals(const Vec3Array& positions, const std::vector<unsigned int>& corners) {
+	size_t count = corners.size() / 3;
+	resize(count);
+	size_t i = 0;
+#ifdef OFX_BLENDER_SSE2
+	const float* px = positions.x.data();
+	const float* py = positions.y.data();
+	const float* pz = positions.z.data();
+	for(; i + 4 <= count; i += 4) {
+		//the corners of four triangles are gathered, the rest is done on all four at once
+		const unsigned int* c = &corners[i * 3];
+		__m128 ax = _mm_setr_ps(px[c[0]], px[c[3]], px[c[6]], px[c[9]]);
+		__m128 ay = _mm_setr_ps(py[c[0]], py[c[3]], py[c[6]], py[c[9]]);
+		__m128 az = _mm_setr_ps(pz[c[0]], pz[c[3]], pz[c[6]], pz[c[9]]);
+		__m128 bx = _mm_setr_ps(px[c[1]], px[c[4]], px[c[7]], px[c[10]]);
+		__m128 by = _mm_setr_ps(py[c[1]], py[c[4]], py[c[7]], py[c[10]]);
+		__m128 bz = _mm_setr_ps(pz[c[1]], pz[c[4]], pz[c[7]], pz[c[10]]);
+		__m128 cx = _mm_setr_ps(px[c[2]], px[c[5]], px[c[8]], px[c[11]]);
+		__m128 cy = _mm_setr_ps(py[c[2]], py[c[5]], py[c[8]], py[c[11]]);
+		__m128 cz = _mm_setr_ps(pz[c[2]], pz[c[5]], pz[c[8]], pz[c[11]]);
+
+		__m128 e0x = _mm_sub_ps(bx, cx), e0y = _mm_sub_ps(by, cy), e0z = _mm_sub_ps(bz, cz);
+		__m128 e1x = _mm_sub_ps(cx, ax), e1y = _mm_sub_ps(cy, ay), e1z = _mm_sub_ps(cz, az);
+		__m128 nx = _mm_sub_ps(_mm_mul_ps(e0y, e1z), _mm_mul_ps(e0z, e1y));
+		__m128 ny = _mm_sub_ps(_mm_mul_ps(e0z, e1x), _mm_mul_ps(e0x, e1z));
+		__m128 nz = _mm_sub_ps(_mm_mul_ps(e0x, e1y), _mm_mul_ps(e0y, e1x));
+		normalizeVectors(nx, ny, nz);
+		_mm_storeu_ps(&x[i], nx);
+		_mm_storeu_ps(&y[i], ny);
+		_mm_storeu_ps(&z[i], nz);
+	}
+#endif
+	for(; i<count; i++) {
+		ofVec3f a = positions.get(corners[i * 3]);
+		ofVec3f b = positions.get(corners[i * 3 + 1]);
+		ofVec3f c = positions.get(corners[i * 3 + 2]);
+		set(i, (b - c).crossed(c - a).normalized());
+	}
+}
+
+void Vec3Array::getTransformed(const ofMatrix4x4& matrix, Vec3Array& out) const {
+	out.resize(size());
+	size_t i = 0;
+#ifdef OFX_BLENDER_SSE2
+	//rows of the matrix as in ofMatrix4x4::preMult, including the division by w
+	__m128 m[4][4];
+	for(unsigned int row=0; row<4; row++) {
+		for(unsigned int col=0; col<4; col++)
+			m[row][col] = _mm_set1_ps(matrix(row, col));
+	}
+	const __m128 one = _mm_set1_ps(1);
+	for(; i + 4 <= size(); i += 4) {
+		__m128 vx = _mm_loadu_ps(&x[i]);
+		__m128 vy = _mm_loadu_ps(&y[i]);
+		__m128 vz = _mm_loadu_ps(&z[i]);
+		__m128 d = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][3], vx), _mm_mul_ps(m[1][3], vy)), _mm_mul_ps(m[2][3], vz)), m[3][3]));
+		for(unsigned int col=0; col<3; col++) {
+			__m128 v = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][col], vx), _mm_mul_ps(m[1][col], vy)), _mm_mul_ps(m[2][col], vz)), m[3][col]);
+			float* target = col == 0 ? &out.x[i] : col == 1 ? &out.y[i] : &out.z[i];
+			_mm_storeu_ps(target, _mm_mul_ps(v, d));
+		}
+	}
+#endif
+	for(; i<size(); i++)
+		out.set(i, get(i) * matrix);
+}
+
+size_t Vec3Array::getNumBytes() const {
+	return MemoryReport::getBytes(x) + MemoryReport::getBytes(y) + MemoryReport::getBytes(z);
+}
+
+}
+}
@@ -0,0 +1,49 @@
+#ifndef BLENDER_VEC3ARRAY_H
+#define BLENDER_VEC3ARRAY_H
+
+#include "Utils.h"
+
+namespace ofx {
+namespace blender {
+
+//vectors stored as three arrays of coordinates instead of an array of ofVec3f, so the kernels below process four
+//vectors per instruction with SSE2 if available. the results are the same as with the ofVec3f operations
+class Vec3Array {
+public:
+	size_t size() const;
+	bool empty() const;
+	void resize(size_t size);
+	void reserve(size_t size);
+	void clear();
+	void swap(Vec3Array& other);
+
+	void push_back(const ofVec3f& v);
+	ofVec3f get(size_t index) const;
+	void set(size_t index, const ofVec3f& v);
+
+	//copies count vectors stored as x y z next to each other
+	void setInterleaved(const float* values, size_t count);
+	void getInterleaved(std::vector<ofVec3f>& out) const;
+	//converts count vectors of three shorts each (e.g. blender's normals) and normalizes them
+	void setNormalized(const short* values, size_t count);
+
+	//componentwise minimum and maximum, returns false and leaves min and max alone if empty
+	bool getBounds(ofVec3f& min, ofVec3f& max) const;
+	//zero length vectors stay zero
+	void normalize();
+	//normalized (b - c) x (c - a) of the triangles abc, corners holds 3 indices into positions per triangle
+	void setFaceNormals(const Vec3Array& positions, const std::vector<unsigned int>& corners);
+	//v * matrix for every vector
+	void getTransformed(const ofMatrix4x4& matrix, Vec3Array& out) const;
+
+	size_t getNumBytes() const;
+
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+};
+
+}
+}
+
+#endif // BLENDER_VEC3ARRAY_H
@@ -1 +1,2 @@
 #include "File.h"
+#include "LoadHandle.h"